@@ -0,0 +1,117 @@
+#include "BatchRunner.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+BatchRunner::BatchRunner(const std::string& config, const std::string& sweep)
+	: m_config(config)
+{
+	// Reads in the sweep file, one "Run SEED TICKS SI SMIN SMAX L BL" line per game
+	std::ifstream fin(sweep);
+	std::string type;
+
+	if (!fin)
+	{
+		throw std::runtime_error("Could not open sweep file '" + sweep + "'");
+	}
+
+	while (fin >> type)
+	{
+		if (type == "Run")
+		{
+			BatchRun r;
+			fin >> r.seed >> r.ticks >> r.SI >> r.SMIN >> r.SMAX >> r.L >> r.BL;
+			m_runs.push_back(r);
+		}
+		else
+		{
+			throw std::runtime_error("File path '" + sweep + "' Object type '" + type + "' is unidentified!");
+		}
+	}
+
+	m_results.resize(m_runs.size());
+}
+
+void BatchRunner::run(unsigned int threads)
+{
+	std::vector<std::thread> workers;
+	m_nextRun = 0;
+
+	for (unsigned int i = 0; i < std::max(1u, threads); i++)
+	{
+		workers.emplace_back(&BatchRunner::worker, this);
+	}
+
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+}
+
+void BatchRunner::worker()
+{
+	Trace::setThreadName("batch worker");
+
+	// every game is independent, so workers only share the index of the next run
+	for (size_t i = m_nextRun++; i < m_runs.size(); i = m_nextRun++)
+	{
+		const BatchRun& r = m_runs[i];
+		BatchResult& result = m_results[i];
+		result.run = r;
+
+		try
+		{
+			Game game(m_config, GameMode::Simulate, r.seed);
+			game.enemyConfig().SI	= r.SI;
+			game.enemyConfig().SMIN	= r.SMIN;
+			game.enemyConfig().SMAX	= r.SMAX;
+			game.enemyConfig().L	= r.L;
+			game.bulletConfig().L	= r.BL;
+
+			game.simulate(r.ticks);
+			result.stats = game.stats();
+		}
+		catch (const std::exception& e)
+		{
+			result.error = e.what();
+		}
+	}
+}
+
+void BatchRunner::report(std::ostream& out) const
+{
+	// one csv line per run followed by the averages over all runs that finished
+	out << "seed,ticks,SI,SMIN,SMAX,L,BL,score,deaths,survival_ticks,peak_entities,us_per_tick,error\n";
+
+	GameStats total;
+	int finished = 0;
+
+	for (auto& r : m_results)
+	{
+		out << r.run.seed << "," << r.run.ticks << "," << r.run.SI << "," << r.run.SMIN << "," << r.run.SMAX << ","
+			<< r.run.L << "," << r.run.BL << "," << r.stats.score << "," << r.stats.deaths << "," << r.stats.survivalTicks << ","
+			<< r.stats.peakEntities << "," << r.stats.tickMicros << "," << r.error << "\n";
+
+		if (r.error.empty())
+		{
+			total.score			+= r.stats.score;
+			total.deaths		+= r.stats.deaths;
+			total.survivalTicks	+= r.stats.survivalTicks;
+			total.peakEntities	 = std::max(total.peakEntities, r.stats.peakEntities);
+			total.tickMicros	+= r.stats.tickMicros;
+			finished++;
+		}
+	}
+
+	if (finished > 0)
+	{
+		out << "\nruns " << finished << " / " << m_results.size()
+			<< "\nmean score " << (double)total.score / finished
+			<< "\nmean deaths " << (double)total.deaths / finished
+			<< "\nmean survival ticks " << (double)total.survivalTicks / finished
+			<< "\npeak entities " << total.peakEntities
+			<< "\nmean us per tick " << total.tickMicros / finished << "\n";
+	}
+}
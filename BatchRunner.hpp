@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Game.hpp"
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// one game of a balance sweep: the seed, how long to play and the config values to try
+struct BatchRun		{ unsigned int seed; int ticks, SI, L, BL; float SMIN, SMAX; };
+struct BatchResult	{ BatchRun run; GameStats stats; std::string error; };
+
+class BatchRunner
+{
+	std::string					m_config;		// base config file every game starts from
+	std::vector<BatchRun>		m_runs;
+	std::vector<BatchResult>	m_results;
+	std::atomic<size_t>			m_nextRun{ 0 };	// index of the next run a worker picks up
+
+	void worker();
+
+public:
+
+	BatchRunner(const std::string& config, const std::string& sweep);
+
+	void run(unsigned int threads);				// play every run, spread over the given number of threads
+	void report(std::ostream& out) const;
+};
@@ -0,0 +1,261 @@
+#include "Client.hpp"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+Client::Client(const std::string& config, const std::string& server, const std::string& path, bool standin)
+	: m_socket(path)
+	, m_server(server)
+	, m_standin(standin)
+{
+	init(config);
+}
+
+Client::~Client()
+{
+	send(PACKET_BYE);
+}
+
+void Client::init(const std::string& path)
+{
+	// Reads the window and font from the config file, the server owns everything else
+	std::ifstream fin(path);
+	std::string type, fontAdd;
+
+	while (fin >> type)
+	{
+		if (type == "Window")
+		{
+			fin >> m_windowConfig.W >> m_windowConfig.H >> m_windowConfig.FL >> m_windowConfig.FS;
+		}
+		else if (type == "Font" && !m_standin)
+		{
+			FontConfig font;
+			fin >> fontAdd >> font.S >> font.R >> font.G >> font.B;
+
+			if (!m_font.loadFromFile(fontAdd))
+			{
+				throw std::runtime_error("Could not load font '" + fontAdd + "'");
+			}
+
+			m_text.setCharacterSize(font.S);
+			m_text.setFillColor(sf::Color(font.R, font.G, font.B));
+			m_text.setFont(m_font);
+		}
+		else
+		{
+			std::getline(fin, type);
+		}
+	}
+
+	if (m_windowConfig.FL > 0)
+	{
+		m_tickRate = m_windowConfig.FL;
+	}
+
+	if (!m_standin)
+	{
+		m_window = std::make_unique<sf::RenderWindow>(sf::VideoMode(m_windowConfig.W, m_windowConfig.H), "Shape Wars");
+		m_window->setFramerateLimit(m_windowConfig.FL);
+	}
+}
+
+void Client::run(int ticks)
+{
+	sf::Clock clock;
+	sf::Time frame = m_windowConfig.FL > 0 ? sf::seconds(1.0f / m_windowConfig.FL) : sf::Time::Zero;
+
+	send(PACKET_HELLO);
+
+	while (m_running && (ticks == 0 || m_currentFrame < ticks))
+	{
+		clock.restart();
+
+		if (m_standin)
+		{
+			sScript();
+		}
+		else
+		{
+			sUserInput();
+		}
+
+		send(PACKET_INPUT);
+		m_input.shoot = false;
+		m_input.special = false;
+
+		receive();
+
+		if (m_standin)
+		{
+			sf::sleep(frame - clock.getElapsedTime());
+		}
+		else
+		{
+			sRender();
+		}
+
+		m_currentFrame++;
+	}
+
+	std::cout << "Client received " << m_snapshots << " snapshots, " << m_bytesReceived << " bytes ("
+		<< (m_snapshots > 0 ? m_bytesReceived / m_snapshots : 0) << " per snapshot), " << m_dropped << " dropped, "
+		<< m_world.size() << " entities in the last one\n";
+}
+
+void Client::send(PacketType type)
+{
+	PacketWriter out;
+	out.u8(type);
+	if (type == PACKET_INPUT)
+	{
+		writeInput(out, m_input);
+	}
+	m_socket.send(m_server, out.data());
+}
+
+void Client::receive()
+{
+	std::vector<uint8_t> data;
+	std::string from;
+
+	while (m_socket.receive(data, from))
+	{
+		PacketReader in(data);
+		if (in.u8() != PACKET_SNAPSHOT)
+		{
+			continue;
+		}
+
+		uint32_t sequence	= in.u32();
+		uint32_t baseline	= in.u32();
+		uint32_t playerId	= in.u32();
+		int32_t score		= in.i32();
+
+		// an older snapshot than the one we have is of no use
+		if (sequence <= m_input.ack)
+		{
+			continue;
+		}
+
+		NetWorld world;
+		if (baseline != 0)
+		{
+			const NetWorld* base = m_history.find(baseline);
+			if (!base)
+			{
+				m_dropped++;
+				continue;
+			}
+			world = *base;
+		}
+
+		for (uint16_t i = 0, removed = in.u16(); i < removed; i++)
+		{
+			world.erase(in.u32());
+		}
+		for (uint16_t i = 0, changed = in.u16(); i < changed; i++)
+		{
+			readEntityDelta(in, world);
+		}
+
+		if (!in.ok())
+		{
+			m_dropped++;
+			continue;
+		}
+
+		// remember the world so the server can use it as a baseline once we ack it
+		m_history.store(sequence, world);
+		m_world = world;
+		m_playerId = playerId;
+		m_score = score;
+		m_input.ack = sequence;
+
+		m_bytesReceived += data.size();
+		m_snapshots++;
+	}
+}
+
+void Client::sScript()
+{
+	// the stand-in runs in a square, changing direction every second, and shoots around itself
+	int side = (m_currentFrame / m_tickRate) % 4;
+	m_input.right	= side == 0;
+	m_input.down	= side == 1;
+	m_input.left	= side == 2;
+	m_input.up		= side == 3;
+
+	auto player = m_world.find(m_playerId);
+	if (player != m_world.end() && m_currentFrame % 15 == 0)
+	{
+		float angle = m_currentFrame * 0.1f;
+		Vec2 pos = player->second.position();
+		m_input.targetX = (int16_t)(pos.x + 100 * cos(angle));
+		m_input.targetY = (int16_t)(pos.y + 100 * sin(angle));
+		m_input.shoot = true;
+		m_input.special = m_currentFrame % (m_tickRate * 5) == 0;
+	}
+}
+
+void Client::sRender()
+{
+	m_window->clear();
+
+	for (auto& [id, e] : m_world)
+	{
+		m_shape.setRadius(e.radius);
+		m_shape.setPointCount(e.points);
+		m_shape.setOrigin(e.radius, e.radius);
+		m_shape.setFillColor(e.fill);
+		m_shape.setOutlineColor(e.outline);
+		m_shape.setOutlineThickness(e.thickness);
+
+		// the server spins entities itself now, their angle comes with the snapshot
+		Vec2 pos = e.position();
+		m_shape.setPosition(pos.x, pos.y);
+		m_shape.setRotation(e.degrees());
+
+		m_window->draw(m_shape);
+	}
+
+	m_text.setString("Score : " + std::to_string(m_score));
+	m_window->draw(m_text);
+
+	m_window->display();
+}
+
+void Client::sUserInput()
+{
+	sf::Event event;
+	while (m_window->pollEvent(event))
+	{
+		if (event.type == sf::Event::Closed)
+		{
+			m_running = false;
+		}
+
+		if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
+		{
+			bool pressed = event.type == sf::Event::KeyPressed;
+			switch (event.key.code)
+			{
+			case sf::Keyboard::W: m_input.up = pressed; break;
+			case sf::Keyboard::A: m_input.left = pressed; break;
+			case sf::Keyboard::S: m_input.down = pressed; break;
+			case sf::Keyboard::D: m_input.right = pressed; break;
+			case sf::Keyboard::Escape: m_running = false; break;
+			default: break;
+			}
+		}
+
+		if (event.type == sf::Event::MouseButtonPressed)
+		{
+			m_input.targetX = (int16_t)event.mouseButton.x;
+			m_input.targetY = (int16_t)event.mouseButton.y;
+			m_input.shoot	= m_input.shoot || event.mouseButton.button == sf::Mouse::Left;
+			m_input.special	= m_input.special || event.mouseButton.button == sf::Mouse::Right;
+		}
+	}
+}
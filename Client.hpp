@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Game.hpp"
+#include "Net.hpp"
+#include "Snapshot.hpp"
+
+// connects to a Server, sends the user's input and draws the snapshots it receives
+class Client
+{
+	Socket				m_socket;
+	std::string			m_server;				// socket path of the server
+	bool				m_standin;				// scripted input and no window, for testing on one machine
+	std::unique_ptr<sf::RenderWindow> m_window;	// null for a stand-in, SFML needs a display even for an unopened window
+	sf::CircleShape		m_shape;				// reused to draw every entity
+	sf::Font			m_font;
+	sf::Text			m_text;
+	WindowConfig		m_windowConfig;
+	int					m_tickRate = 60;		// ticks per second, the frame limit unless that is 0
+	SnapshotHistory		m_history;				// decoded worlds by sequence, the baselines of future deltas
+	NetWorld			m_world;				// the newest decoded world, the one drawn
+	NetInput			m_input;
+	uint32_t			m_playerId = 0;
+	int					m_score = 0;
+	int					m_currentFrame = 0;
+	bool				m_running = true;
+	size_t				m_bytesReceived = 0;
+	size_t				m_snapshots = 0;
+	size_t				m_dropped = 0;			// snapshots whose baseline was no longer kept
+
+	void init(const std::string& config);
+	void send(PacketType type);
+	void receive();
+
+	void sUserInput();							// System: User Input
+	void sScript();								// System: Scripted input of a stand-in client
+	void sRender();								// System: Render / Drawing
+
+public:
+
+	Client(const std::string& config, const std::string& server, const std::string& path, bool standin);
+	~Client();
+
+	void run(int ticks);						// run for a number of frames, until the window closes if ticks is 0
+};
@@ -1,67 +1,90 @@
-#pragma once
-
-#include "Vec2.hpp"
-#include <SFML/Graphics.hpp>
-
-class CTransform
-{
-public:
-	Vec2 pos		= { 0.0, 0.0 };
-	Vec2 velocity	= { 0.0, 0.0 };
-	float angle		= 0.0;
-
-	CTransform(const Vec2& p, const Vec2& v, float a = 0.0)
-		: pos(p), velocity(v), angle(a) {}
-};
-
-class CShape
-{
-public:
-	sf::CircleShape circle;
-
-	CShape(float radius, int points, const sf::Color& fill, const sf::Color& outline, float thickness)
-		: circle(radius, points)
-	{
-		circle.setFillColor(fill);
-		circle.setOutlineColor(outline);
-		circle.setOutlineThickness(thickness);
-		circle.setOrigin(radius, radius);
-	}
-};
-
-class CCollision
-{
-public:
-	float radius = 0;
-	CCollision(float r)
-		: radius(r) {}
-};
-
-class CScore
-{
-public:
-	int score = 0;
-	CScore(int s)
-		: score(s) {}
-};
-
-class CLifespan
-{
-public:
-	int remaining	= 0;	// amount of lifespawn remaining on the entity
-	int total		= 0;	// the total initial amoun of lifespawn
-	CLifespan(int total)
-		: remaining(total), total(total) {}
-};
-
-class CInput
-{
-public:
-	bool up		= false;
-	bool left	= false;
-	bool right	= false;
-	bool down	= false;
-	bool shoot	= false;
-
-	CInput() {}
+#pragma once
+
+#include "Vec2.hpp"
+#include <SFML/Graphics.hpp>
+
+class CTransform
+{
+public:
+	Vec2 pos		= { 0.0, 0.0 };
+	Vec2 velocity	= { 0.0, 0.0 };
+	float angle		= 0.0;
+
+	CTransform(const Vec2& p, const Vec2& v, float a = 0.0)
+		: pos(p), velocity(v), angle(a) {}
+};
+
+class CShape
+{
+public:
+	sf::CircleShape circle;
+
+	CShape(float radius, int points, const sf::Color& fill, const sf::Color& outline, float thickness)
+		: circle(radius, points)
+	{
+		circle.setFillColor(fill);
+		circle.setOutlineColor(outline);
+		circle.setOutlineThickness(thickness);
+		circle.setOrigin(radius, radius);
+	}
+};
+
+class CCollision
+{
+public:
+	float radius = 0;
+	CCollision(float r)
+		: radius(r) {}
+};
+
+class CScore
+{
+public:
+	int score = 0;
+	CScore(int s)
+		: score(s) {}
+};
+
+class CLifespan
+{
+public:
+	int remaining	= 0;	// amount of lifespawn remaining on the entity
+	int total		= 0;	// the total initial amoun of lifespawn
+	CLifespan(int total)
+		: remaining(total), total(total) {}
+};
+
+class CEmitter
+{
+public:
+	float radius	= 0;	// how far the emitter's field reaches
+	float strength	= 0;	// pull per pixel of distance to the emitter, negative pushes away
+	CEmitter(float r, float s)
+		: radius(r), strength(s) {}
+};
+
+class CSteering
+{
+public:
+	Vec2 force		= { 0.0, 0.0 };	// change of velocity the flock asked for on the last tick
+	CSteering() {}
+};
+
+class CCooldown
+{
+public:
+	int special		= 0;	// frame from which the special weapon can be fired again
+	CCooldown() {}
+};
+
+class CInput
+{
+public:
+	bool up		= false;
+	bool left	= false;
+	bool right	= false;
+	bool down	= false;
+	bool shoot	= false;
+
+	CInput() {}
 };
\ No newline at end of file
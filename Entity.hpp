@@ -1,33 +1,36 @@
-#pragma once
-
-#include "Components.hpp"
-#include <memory>
-#include <string>
-
-class Entity
-{
-	friend class EntityManager;
-
-	bool		m_active	= true;
-	size_t		m_id		= 0;
-	std::string	m_tag		= "default";
-
-	// constructor and destructor
-	Entity(const size_t id, const std::string& tag);
-
-public:
-
-	//component pointers
-	std::shared_ptr<CTransform>	cTransform;
-	std::shared_ptr<CShape>		cShape;
-	std::shared_ptr<CCollision>	cCollision;
-	std::shared_ptr<CInput>		cInput;
-	std::shared_ptr<CScore>		cScore;
-	std::shared_ptr<CLifespan>	cLifespan;
-
-	//private member access functions
-	bool isActive() const;
-	const std::string& tag() const;
-	const size_t id() const;
-	void destroy();
+#pragma once
+
+#include "Components.hpp"
+#include <memory>
+#include <string>
+
+class Entity
+{
+	friend class EntityManager;
+
+	bool		m_active	= true;
+	size_t		m_id		= 0;
+	std::string	m_tag		= "default";
+
+	// constructor and destructor
+	Entity(const size_t id, const std::string& tag);
+
+public:
+
+	//component pointers
+	std::shared_ptr<CTransform>	cTransform;
+	std::shared_ptr<CShape>		cShape;
+	std::shared_ptr<CCollision>	cCollision;
+	std::shared_ptr<CInput>		cInput;
+	std::shared_ptr<CScore>		cScore;
+	std::shared_ptr<CLifespan>	cLifespan;
+	std::shared_ptr<CEmitter>	cEmitter;
+	std::shared_ptr<CSteering>	cSteering;
+	std::shared_ptr<CCooldown>	cCooldown;
+
+	//private member access functions
+	bool isActive() const;
+	const std::string& tag() const;
+	const size_t id() const;
+	void destroy();
 };
\ No newline at end of file
@@ -1,65 +1,325 @@
-#include "EntityManager.hpp"
-#include <iostream>
-
-EntityManager::EntityManager()
-{
-
-}
-
-void EntityManager::update()
-{
-	// add entities from m_entitiesToAdd to the proper location(s)
-	// - add them to the vector of all entities
-	// - add them to the vector inside the map, with the tag as a key
-	for (auto& e : m_entitiesToAdd)
-	{
-		m_entities.push_back(e);
-		m_entityMap[e->m_tag].push_back(e);
-	}
-
-	m_entitiesToAdd.clear();
-
-	// remove dead entities from the vector of all entities
-	removeDeadEntities(m_entities);
-
-	// remove dead entities from each vector in the entity map
-	// C++17 way of iterating through [key, value] pairs in a map
-	for (auto& [tag, entityVec] : m_entityMap)
-	{
-		removeDeadEntities(entityVec);
-	}
-}
-
-void EntityManager::removeDeadEntities(EntityVec& vec)
-{
-	// remove all dead entities from the input vector
-	// this is called by the update() function
-
-	const auto newEnd = std::remove_if(vec.begin(), vec.end(),
-		[](const std::shared_ptr<Entity>& i)
-		{
-			return i->isActive() == false;
-		}
-	);
-
-	vec.erase(newEnd, vec.end());
-}
-
-std::shared_ptr<Entity> EntityManager::addEntity(const std::string& tag)
-{
-	auto entity = std::shared_ptr<Entity>(new Entity(m_totalEntities++, tag));
-
-	m_entitiesToAdd.push_back(entity);
-
-	return entity;
-}
-
-const EntityVec& EntityManager::getEntities()
-{
-	return m_entities;
-}
-
-const EntityVec& EntityManager::getEntities(const std::string& tag)
-{
-	return m_entityMap[tag];
+#include "EntityManager.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <iostream>
+
+EntityManager::EntityManager()
+{
+
+}
+
+void EntityManager::update()
+{
+	TRACE_ZONE("EntityManager::update");
+
+	// add entities from m_entitiesToAdd to the proper location(s)
+	// - add them to the vector of all entities
+	// - add them to the vector inside the map, with the tag as a key
+	// - entities added after a sort gathered its entities still have to go into its tag vectors
+	bool late = m_sortStep == SortStep::Count || m_sortStep == SortStep::Scatter || m_sortStep == SortStep::Place;
+	for (auto& e : m_entitiesToAdd)
+	{
+		m_entities.push_back(e);
+		m_entityMap[e->m_tag].push_back(e);
+		if (late)
+		{
+			m_sortLate.push_back(e);
+		}
+	}
+
+	m_entitiesToAdd.clear();
+
+	// a sort in progress takes the next part of its current step, otherwise one may be due
+	// this comes before removing the dead, so tag vectors the sort swaps in are cleaned up too
+	switch (m_sortStep)
+	{
+	case SortStep::Idle:
+		if (m_sortPeriod > 0 && --m_ticksToSort <= 0)
+		{
+			startSort();
+		}
+		break;
+	case SortStep::Gather:	gather();			break;
+	case SortStep::Count:
+	case SortStep::Scatter:	radixStep();		break;
+	case SortStep::Place:	place();			break;
+	case SortStep::Move:	moveTransforms();	break;
+	}
+
+	// remove dead entities from the vector of all entities
+	// a sort gathering entities from it keeps its place among the ones left
+	removeDeadEntities(m_entities, m_sortStep == SortStep::Gather ? &m_sortNext : nullptr);
+
+	// remove dead entities from each vector in the entity map
+	// C++17 way of iterating through [key, value] pairs in a map
+	for (auto& [tag, entityVec] : m_entityMap)
+	{
+		removeDeadEntities(entityVec);
+	}
+}
+
+void EntityManager::setSpatialOrder(int period, size_t perTick)
+{
+	m_sortPeriod = period;
+	m_sortPerTick = std::max((size_t)1, perTick);
+	m_ticksToSort = period;
+}
+
+// spreads the bits of a 16 bit number out to the even bits of a 32 bit one
+static uint32_t spreadBits(uint32_t v)
+{
+	v &= 0xffff;
+	v = (v | (v << 8)) & 0x00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+// Morton code of a position on a grid of 8 pixel cells, nearby cells mostly get nearby codes
+static uint32_t mortonCode(const Vec2& pos)
+{
+	uint32_t x = (uint32_t)std::min(65535.0f, std::max(0.0f, pos.x / 8.0f));
+	uint32_t y = (uint32_t)std::min(65535.0f, std::max(0.0f, pos.y / 8.0f));
+	return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+void EntityManager::startSort()
+{
+	m_ticksToSort = m_sortPeriod;
+	m_sortNext = 0;
+	m_sortMaxCode = 0;
+	m_sortEntities.clear();
+	m_sortKeys.clear();
+	m_sortStep = SortStep::Gather;
+	gather();
+}
+
+void EntityManager::gather()
+{
+	TRACE_ZONE("EntityManager::gather");
+
+	// the codes come from the positions at the tick each entity is gathered, close enough to sort by
+	// entities without a transform go first, they have to stay in their tag vector all the same
+	size_t end = std::min(m_entities.size(), m_sortNext + m_sortPerTick);
+	for (; m_sortNext < end; m_sortNext++)
+	{
+		auto& e = m_entities[m_sortNext];
+		uint32_t code = e->cTransform ? mortonCode(e->cTransform->pos) : 0;
+		m_sortMaxCode = std::max(m_sortMaxCode, code);
+		m_sortKeys.emplace_back(code, (uint32_t)m_sortEntities.size());
+		m_sortEntities.push_back(e);
+	}
+
+	// entities added meanwhile were appended, so once the end is reached every entity was gathered
+	if (m_sortNext == m_entities.size())
+	{
+		m_sortNext = 0;
+		m_sortShift = 0;
+		m_sortCount.assign(65536, 0);
+		m_sortStep = SortStep::Count;
+	}
+}
+
+void EntityManager::radixStep()
+{
+	TRACE_ZONE("EntityManager::radixStep");
+
+	// a radix sort on 16 bits of the codes at a time, counting and scattering are both a plain pass over
+	// the keys that can stop anywhere, so they are split over ticks like the rest. They are cheap per key
+	// next to the steps that reach into the entities, so each tick does many more of them
+	size_t end = std::min(m_sortKeys.size(), m_sortNext + m_sortPerTick * 16);
+
+	if (m_sortStep == SortStep::Count)
+	{
+		for (; m_sortNext < end; m_sortNext++)
+		{
+			m_sortCount[(m_sortKeys[m_sortNext].first >> m_sortShift) & 0xffff]++;
+		}
+
+		if (m_sortNext == m_sortKeys.size())
+		{
+			// counts become where each digit's keys start
+			uint32_t start = 0;
+			for (auto& c : m_sortCount)
+			{
+				uint32_t n = c;
+				c = start;
+				start += n;
+			}
+			m_sortScratch.resize(m_sortKeys.size());
+			m_sortNext = 0;
+			m_sortStep = SortStep::Scatter;
+		}
+		return;
+	}
+
+	for (; m_sortNext < end; m_sortNext++)
+	{
+		auto& key = m_sortKeys[m_sortNext];
+		m_sortScratch[m_sortCount[(key.first >> m_sortShift) & 0xffff]++] = key;
+	}
+
+	if (m_sortNext < m_sortKeys.size())
+	{
+		return;
+	}
+
+	m_sortKeys.swap(m_sortScratch);
+	m_sortNext = 0;
+
+	// the high bits only need a pass if some code uses them, codes of a screen sized world don't
+	if (m_sortShift == 0 && m_sortMaxCode > 0xffff)
+	{
+		m_sortShift = 16;
+		m_sortCount.assign(65536, 0);
+		m_sortStep = SortStep::Count;
+	}
+	else
+	{
+		m_sortQueue.clear();
+		m_sortTags.clear();
+		m_sortStep = SortStep::Place;
+	}
+}
+
+void EntityManager::place()
+{
+	TRACE_ZONE("EntityManager::place");
+
+	size_t end = std::min(m_sortKeys.size(), m_sortNext + m_sortPerTick);
+	for (; m_sortNext < end; m_sortNext++)
+	{
+		auto& e = m_sortEntities[m_sortKeys[m_sortNext].second];
+		m_sortTags[e->m_tag].push_back(e);
+		m_sortQueue.push_back(std::move(e));
+	}
+
+	if (m_sortNext < m_sortKeys.size())
+	{
+		return;
+	}
+
+	// the tag vectors take their new order all at once, so a system never sees an entity twice or not
+	// at all. Late entities keep their order after the sorted ones, the dead go when update() cleans up
+	for (auto& e : m_sortLate)
+	{
+		m_sortTags[e->m_tag].push_back(std::move(e));
+	}
+	m_sortLate.clear();
+	m_sortEntities.clear();
+
+	// the old vectors let go of their entities a few per tick while the transforms move, that touches
+	// every entity as much as placing them did
+	for (auto& [tag, sorted] : m_sortTags)
+	{
+		m_entityMap[tag].swap(sorted);
+		m_sortOld.push_back(std::move(sorted));
+	}
+	m_sortTags.clear();
+
+	// the transforms move over the next ticks, into a block that never reallocates
+	m_transforms = std::make_shared<std::vector<CTransform>>();
+	m_transforms->reserve(m_sortQueue.size());
+	m_sortNext = 0;
+	m_sortStep = SortStep::Move;
+}
+
+void EntityManager::moveTransforms()
+{
+	TRACE_ZONE("EntityManager::moveTransforms");
+
+	size_t end = std::min(m_sortQueue.size(), m_sortNext + m_sortPerTick);
+
+	for (; m_sortNext < end; m_sortNext++)
+	{
+		// the queue lets go of each entity once it's moved, so it doesn't keep any alive
+		auto e = std::move(m_sortQueue[m_sortNext]);
+		if (!e->isActive() || !e->cTransform)
+		{
+			continue;
+		}
+
+		// the new pointer shares ownership of the whole block, which is freed once no entity uses it
+		// anything still holding the old transform keeps it, it just isn't the entity's any more
+		m_transforms->push_back(*e->cTransform);
+		e->cTransform = std::shared_ptr<CTransform>(m_transforms, &m_transforms->back());
+	}
+
+	// and the old tag vectors let go of as many
+	for (size_t n = 0; n < m_sortPerTick && !m_sortOld.empty(); )
+	{
+		EntityVec& old = m_sortOld.back();
+		size_t count = std::min(old.size(), m_sortPerTick - n);
+		old.resize(old.size() - count);
+		n += count;
+		if (old.empty())
+		{
+			m_sortOld.pop_back();
+		}
+	}
+
+	// done once both are through
+	if (m_sortNext == m_sortQueue.size() && m_sortOld.empty())
+	{
+		m_sortQueue.clear();
+		m_sortNext = 0;
+		m_transforms.reset();
+		m_sortStep = SortStep::Idle;
+	}
+}
+
+void EntityManager::removeDeadEntities(EntityVec& vec, size_t* cursor)
+{
+	// remove all dead entities from the input vector
+	// this is called by the update() function
+
+	// a cursor into the vector moves back by the dead entities before it, so it stays on the same entity
+	if (cursor)
+	{
+		size_t kept = 0, before = *cursor;
+		for (size_t i = 0; i < vec.size(); i++)
+		{
+			if (!vec[i]->isActive())
+			{
+				*cursor -= i < before;
+				continue;
+			}
+			if (kept != i)
+			{
+				vec[kept] = std::move(vec[i]);
+			}
+			kept++;
+		}
+		vec.resize(kept);
+		return;
+	}
+
+	const auto newEnd = std::remove_if(vec.begin(), vec.end(),
+		[](const std::shared_ptr<Entity>& i)
+		{
+			return i->isActive() == false;
+		}
+	);
+
+	vec.erase(newEnd, vec.end());
+}
+
+std::shared_ptr<Entity> EntityManager::addEntity(const std::string& tag)
+{
+	auto entity = std::shared_ptr<Entity>(new Entity(m_totalEntities++, tag));
+
+	m_entitiesToAdd.push_back(entity);
+
+	return entity;
+}
+
+const EntityVec& EntityManager::getEntities()
+{
+	return m_entities;
+}
+
+const EntityVec& EntityManager::getEntities(const std::string& tag)
+{
+	return m_entityMap[tag];
 }
\ No newline at end of file
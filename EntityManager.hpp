@@ -1,29 +1,62 @@
-#pragma once
-
-#include "Entity.hpp"
-#include <vector>
-#include <map>
-
-typedef std::vector<std::shared_ptr<Entity>> EntityVec;
-typedef std::map<std::string, EntityVec>	 EntityMap;
-
-class EntityManager
-{
-	EntityVec	m_entities;
-	EntityVec	m_entitiesToAdd;
-	EntityMap	m_entityMap;
-	size_t		m_totalEntities = 0;
-
-	void removeDeadEntities(EntityVec& vec);
-
-public:
-
-	EntityManager();
-
-	void update();
-
-	std::shared_ptr<Entity> addEntity(const std::string& tag);
-
-	const EntityVec& getEntities();
-	const EntityVec& getEntities(const std::string& tag);
+#pragma once
+
+#include "Entity.hpp"
+#include <cstdint>
+#include <vector>
+#include <map>
+
+typedef std::vector<std::shared_ptr<Entity>> EntityVec;
+typedef std::map<std::string, EntityVec>	 EntityMap;
+
+class EntityManager
+{
+	EntityVec	m_entities;
+	EntityVec	m_entitiesToAdd;
+	EntityMap	m_entityMap;
+	size_t		m_totalEntities = 0;
+
+	// spatial order, see setSpatialOrder. A sort goes through these steps, one step's share of the work per tick
+	enum class SortStep { Idle, Gather, Count, Scatter, Place, Move };
+
+	int			m_sortPeriod	= 0;		// ticks between sorts, 0 is off
+	size_t		m_sortPerTick	= 1024;		// entities gathered, placed or moved per tick
+	int			m_ticksToSort	= 0;
+	SortStep	m_sortStep		= SortStep::Idle;
+	size_t		m_sortNext		= 0;		// where the current step carries on next tick
+	int			m_sortShift		= 0;		// the 16 bits of the codes the radix sort is on
+	uint32_t	m_sortMaxCode	= 0;
+	EntityVec	m_sortEntities;				// gathered entities, in m_entities order
+	std::vector<std::pair<uint32_t, uint32_t>>	m_sortKeys;		// Morton code and index into m_sortEntities
+	std::vector<std::pair<uint32_t, uint32_t>>	m_sortScratch;	// the other buffer of the radix sort
+	std::vector<uint32_t>						m_sortCount;	// entities per digit, then where each digit goes
+	EntityMap	m_sortTags;					// the tag vectors in their new order, swapped in once complete
+	EntityVec	m_sortLate;					// entities added after the gather, for the new tag vectors
+	std::vector<EntityVec>	m_sortOld;		// tag vectors replaced by the sort, emptied while the transforms move
+	EntityVec	m_sortQueue;				// entities whose transforms are still to be moved, in Morton order
+	std::shared_ptr<std::vector<CTransform>>	m_transforms;	// block the current sort moves transforms into
+
+	void removeDeadEntities(EntityVec& vec, size_t* cursor = nullptr);
+	void startSort();
+	void gather();
+	void radixStep();
+	void place();
+	void moveTransforms();
+
+public:
+
+	EntityManager();
+
+	void update();
+
+	// every period ticks, reorder the tag vectors by the Morton (Z-order) code of the entities' position
+	// and move their transforms into one block in that order, so entities close on screen are close in memory.
+	// Every step is spread over ticks, perTick entities at a time. The vector of all entities keeps its
+	// order, which is the order entities are drawn in. Entity pointers stay the same, only cTransform is
+	// pointed at the copy
+	void setSpatialOrder(int period, size_t perTick);
+
+	std::shared_ptr<Entity> addEntity(const std::string& tag);
+
+	const EntityVec& getEntities();
+	const EntityVec& getEntities(const std::string& tag);
 };
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "EventLog.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+EventLog::EventLog()
+{
+}
+
+EventLog::~EventLog()
+{
+	close();
+}
+
+bool EventLog::open(const std::string& path, size_t recordsPerSegment)
+{
+	close();
+
+	m_path		= path;
+	m_capacity	= recordsPerSegment;
+	m_used		= 0;
+	m_sequence	= 0;
+	m_segment	= 0;
+	m_stop		= false;
+	m_failed	= false;
+
+	m_current = map(0);
+	if (!m_current.records)
+	{
+		return false;
+	}
+
+	m_next = map(1);
+	m_thread = std::thread(&EventLog::background, this);
+	return true;
+}
+
+void EventLog::close()
+{
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_one();
+		m_thread.join();
+	}
+
+	unmap(m_current);
+	unmap(m_next);
+	for (auto& s : m_full)
+	{
+		unmap(s);
+	}
+	m_full.clear();
+
+	// the segment mapped ahead was never written to
+	if (m_capacity > 0)
+	{
+		char name[16];
+		snprintf(name, sizeof(name), ".%03d", m_segment + 1);
+		unlink((m_path + name).c_str());
+	}
+	m_capacity = 0;
+}
+
+bool EventLog::isOpen() const
+{
+	return m_current.records != nullptr;
+}
+
+EventLog::Segment EventLog::map(int number)
+{
+	char name[16];
+	snprintf(name, sizeof(name), ".%03d", number);
+
+	// a new segment file is all zeros, which reads back as EVENT_NONE after the last record
+	Segment s;
+	size_t bytes = m_capacity * sizeof(EventRecord);
+	s.fd = ::open((m_path + name).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (s.fd < 0 || ftruncate(s.fd, bytes) != 0)
+	{
+		unmap(s);
+		return Segment();
+	}
+
+	// populating the mapping here faults every page in on the background thread instead of in write()
+	int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+	flags |= MAP_POPULATE;
+#endif
+
+	void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, s.fd, 0);
+	if (memory == MAP_FAILED)
+	{
+		unmap(s);
+		return Segment();
+	}
+
+	// writing each page once marks it dirty up front, so write() doesn't take that fault either
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	for (size_t offset = 0; offset < bytes; offset += page)
+	{
+		((volatile char*)memory)[offset] = 0;
+	}
+
+	s.records = (EventRecord*)memory;
+	return s;
+}
+
+void EventLog::unmap(Segment& s)
+{
+	if (s.records)
+	{
+		munmap(s.records, m_capacity * sizeof(EventRecord));
+	}
+	if (s.fd >= 0)
+	{
+		::close(s.fd);
+	}
+	s = Segment();
+}
+
+void EventLog::rotate()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// the next segment is normally mapped long before it is needed, the game thread
+	// only waits here if segments fill faster than the background thread maps them
+	m_ready.wait(lock, [this] { return m_next.records || m_failed; });
+
+	// the full segment is still unmapped, but without a next one there is nowhere left to write
+	m_full.push_back(m_current);
+	if (!m_next.records)
+	{
+		m_current = Segment();
+		lock.unlock();
+		m_wake.notify_one();
+		return;
+	}
+
+	m_current = m_next;
+	m_next = Segment();
+	m_used = 0;
+	m_segment++;
+
+	lock.unlock();
+	m_wake.notify_one();
+}
+
+void EventLog::background()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (!m_stop)
+	{
+		// once mapping failed there is no next segment to map, only full ones to unmap
+		m_wake.wait(lock, [this] { return m_stop || !m_full.empty() || (!m_next.records && !m_failed); });
+
+		std::vector<Segment> full;
+		full.swap(m_full);
+		bool mapNext = !m_next.records && !m_stop && !m_failed;
+		int number = m_segment + 1;
+
+		// file system work happens without the lock, the game thread keeps writing meanwhile
+		lock.unlock();
+		for (auto& s : full)
+		{
+			unmap(s);
+		}
+		Segment next = mapNext ? map(number) : Segment();
+		lock.lock();
+
+		if (mapNext)
+		{
+			// if the file system fails, logging stops instead of the game
+			m_next = next;
+			m_failed = !next.records;
+			m_ready.notify_one();
+		}
+	}
+}
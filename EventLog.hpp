@@ -0,0 +1,108 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum EventType : uint8_t
+{
+	EVENT_NONE		= 0,	// unwritten space at the end of a segment
+	EVENT_SPAWN		= 1,
+	EVENT_KILL		= 2,	// value is the score awarded, other is the killer
+	EVENT_DEATH		= 3,	// a player died, other is the enemy
+	EVENT_RESPAWN	= 4,
+	EVENT_SPECIAL	= 5		// a special weapon was fired, other is the player
+};
+
+inline const char* eventName(uint8_t type)
+{
+	static const char* names[] = { "none", "spawn", "kill", "death", "respawn", "special" };
+	return type < sizeof(names) / sizeof(names[0]) ? names[type] : "unknown";
+}
+
+// one gameplay event, fixed size so a segment file is just an array of them
+struct EventRecord
+{
+	uint32_t	sequence;		// index of the record in the whole log, a gap means records were lost
+	uint32_t	tick;
+	uint8_t		type;			// EventType
+	uint8_t		tag;			// tagId() of the entity
+	uint8_t		otherTag;
+	uint8_t		padding;
+	uint32_t	entity;
+	uint32_t	other;
+	int32_t		value;
+	float		x;
+	float		y;
+};
+
+static_assert(sizeof(EventRecord) == 32, "event records are written to disk as is");
+
+// an append-only log of EventRecords in memory mapped segment files, path.000, path.001, ...
+// write() only copies a record into the mapped segment, a background thread maps the next segment
+// ahead of time and unmaps full ones, so the game thread never waits on the file system
+class EventLog
+{
+	// a memory mapped segment file
+	struct Segment
+	{
+		int				fd		= -1;
+		EventRecord*	records	= nullptr;
+	};
+
+	std::string				m_path;
+	size_t					m_capacity	= 0;	// records per segment
+	Segment					m_current;
+	size_t					m_used		= 0;	// records written to the current segment
+	uint32_t				m_sequence	= 0;
+	int						m_segment	= 0;	// number of the current segment
+
+	std::thread				m_thread;
+	std::mutex				m_mutex;
+	std::condition_variable	m_wake;				// wakes the background thread
+	std::condition_variable	m_ready;			// wakes the game thread when the next segment is mapped
+	Segment					m_next;				// mapped ahead by the background thread
+	std::vector<Segment>	m_full;				// waiting to be unmapped by the background thread
+	bool					m_stop		= false;
+	bool					m_failed	= false;	// a segment could not be mapped, nothing more is written
+
+	Segment map(int number);
+	void unmap(Segment& segment);
+	void rotate();
+	void background();
+
+public:
+
+	EventLog();
+	~EventLog();
+
+	EventLog(const EventLog&) = delete;
+	EventLog& operator = (const EventLog&) = delete;
+
+	bool open(const std::string& path, size_t recordsPerSegment);
+	void close();
+	bool isOpen() const;
+
+	void write(EventRecord record)
+	{
+		if (!m_current.records)
+		{
+			return;
+		}
+		if (m_used == m_capacity)
+		{
+			rotate();
+
+			// the next segment could not be mapped, the record is dropped like every one after it
+			if (!m_current.records)
+			{
+				return;
+			}
+		}
+		record.sequence = m_sequence++;
+		m_current.records[m_used++] = record;
+	}
+};
@@ -0,0 +1,94 @@
+#include "ForceField.hpp"
+#include <algorithm>
+#include <cmath>
+
+void ForceField::resize(float width, float height, float cellSize)
+{
+	m_cellSize = cellSize;
+	m_width = (int)std::ceil(width / cellSize) + 1;
+	m_height = (int)std::ceil(height / cellSize) + 1;
+	m_pull.assign(m_width * m_height, Vec2(0.0f, 0.0f));
+	m_weight.assign(m_width * m_height, 0.0f);
+}
+
+void ForceField::clear()
+{
+	if (m_empty)
+	{
+		return;
+	}
+
+	m_empty = true;
+	std::fill(m_pull.begin(), m_pull.end(), Vec2(0.0f, 0.0f));
+	std::fill(m_weight.begin(), m_weight.end(), 0.0f);
+}
+
+void ForceField::addEmitter(const Vec2& center, float radius, float strength)
+{
+	m_empty = false;
+
+	// only the cells whose centres are inside the radius are touched
+	int x0 = std::max(0, (int)std::floor((center.x - radius) / m_cellSize));
+	int y0 = std::max(0, (int)std::floor((center.y - radius) / m_cellSize));
+	int x1 = std::min(m_width - 1, (int)std::ceil((center.x + radius) / m_cellSize));
+	int y1 = std::min(m_height - 1, (int)std::ceil((center.y + radius) / m_cellSize));
+
+	for (int cy = y0; cy <= y1; cy++)
+	{
+		for (int cx = x0; cx <= x1; cx++)
+		{
+			Vec2 toCenter = Vec2(cx * m_cellSize, cy * m_cellSize).dist(center);
+			float d2 = toCenter.x * toCenter.x + toCenter.y * toCenter.y;
+			if (d2 >= radius * radius)
+			{
+				continue;
+			}
+			float d = std::sqrt(d2);
+
+			// full influence inside, fading out over the outer quarter of the radius
+			float weight = std::min(1.0f, (1.0f - d / radius) * 4.0f);
+			m_pull[cy * m_width + cx] += toCenter * (strength * weight);
+			m_weight[cy * m_width + cx] += weight;
+		}
+	}
+}
+
+void ForceField::cell(int cx, int cy, Vec2& pull, float& weight) const
+{
+	cx = std::max(0, std::min(m_width - 1, cx));
+	cy = std::max(0, std::min(m_height - 1, cy));
+	pull = m_pull[cy * m_width + cx];
+	weight = m_weight[cy * m_width + cx];
+}
+
+Vec2 ForceField::apply(const Vec2& pos, const Vec2& velocity, float response) const
+{
+	if (m_empty)
+	{
+		return velocity;
+	}
+
+	// bilinear blend of the four surrounding cells so the pull changes smoothly across cell borders
+	float fx = pos.x / m_cellSize, fy = pos.y / m_cellSize;
+	int cx = (int)std::floor(fx), cy = (int)std::floor(fy);
+	float tx = fx - cx, ty = fy - cy;
+
+	Vec2 p00, p10, p01, p11;
+	float w00, w10, w01, w11;
+	cell(cx, cy, p00, w00);
+	cell(cx + 1, cy, p10, w10);
+	cell(cx, cy + 1, p01, w01);
+	cell(cx + 1, cy + 1, p11, w11);
+
+	float a = (1 - tx) * (1 - ty), b = tx * (1 - ty), c = (1 - tx) * ty, d = tx * ty;
+	float weight = w00 * a + w10 * b + w01 * c + w11 * d;
+	if (weight <= 0.0f)
+	{
+		return velocity;
+	}
+
+	// the pull is stored weighted, so divide it back out before steering towards it
+	Vec2 pull = (p00 * a + p10 * b + p01 * c + p11 * d) / weight;
+	float blend = std::min(1.0f, weight) * response;
+	return velocity + (pull - velocity) * blend;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Vec2.hpp"
+#include <vector>
+
+// a coarse grid of pull vectors written by emitters each tick and sampled by moving entities
+// sampling is O(1) no matter how many emitters wrote into the grid
+class ForceField
+{
+	float				m_cellSize	= 32.0f;
+	int					m_width		= 0;	// in cells
+	int					m_height	= 0;
+	std::vector<Vec2>	m_pull;				// velocity the field pulls entities in a cell towards
+	std::vector<float>	m_weight;			// how strongly, 0 is no influence and 1 is full
+	bool				m_empty		= true;	// no emitter wrote since the last clear
+
+	void cell(int cx, int cy, Vec2& pull, float& weight) const;
+
+public:
+
+	void resize(float width, float height, float cellSize);
+	void clear();
+
+	// pull = (center - pos) * strength inside radius, a negative strength pushes away
+	void addEmitter(const Vec2& center, float radius, float strength);
+
+	// blends a velocity towards the field's pull at pos, response is the blend per tick at full weight
+	Vec2 apply(const Vec2& pos, const Vec2& velocity, float response) const;
+};
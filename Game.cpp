@@ -1,554 +1,1356 @@
-#include "Game.hpp"
-#include <iostream>
-#include <fstream>
-
-Game::Game(const std::string& config)
-{
-	init(config);
-}
-
-void Game::init(const std::string& path)
-{
-	// Reads in config file
-	std::ifstream  fin(path);
-	std::string type, fontAdd;
-
-	while (fin >> type)
-	{
-		if (type == "Window")
-		{
-			fin >> m_windowConfig.W >> m_windowConfig.H >> m_windowConfig.FL >> m_windowConfig.FS;
-		}
-		else if (type == "Font")
-		{
-			fin >> fontAdd >> m_fontConfig.S >> m_fontConfig.R >> m_fontConfig.G >> m_fontConfig.B;
-
-			// attempt to load the font from a file
-			if (!m_font.loadFromFile(fontAdd))
-			{
-				// if we can't load the font, print an error to the error console and exit
-				std::cerr << "Could not load font\n";
-				exit(-1);
-			}
-
-			m_text.setCharacterSize(m_fontConfig.S);
-			m_text.setFillColor(sf::Color(m_fontConfig.R, m_fontConfig.G, m_fontConfig.B));
-			m_text.setFont(m_font);
-		}
-		else if (type == "Player")
-		{
-			fin >> m_playerConfig.SR >> m_playerConfig.CR >> m_playerConfig.S >> m_playerConfig.FR >> m_playerConfig.FG >> m_playerConfig.FB;
-			fin >> m_playerConfig.OR >> m_playerConfig.OG >> m_playerConfig.OB >> m_playerConfig.OT >> m_playerConfig.V;
-		}
-		else if (type == "Enemy")
-		{
-			fin >> m_enemyConfig.SR >> m_enemyConfig.CR >> m_enemyConfig.SMIN >> m_enemyConfig.SMAX >> m_enemyConfig.OR >> m_enemyConfig.OG;
-			fin >> m_enemyConfig.OB >> m_enemyConfig.OT >> m_enemyConfig.VMIN >> m_enemyConfig.VMAX >> m_enemyConfig.L >> m_enemyConfig.SI;
-		}
-		else if (type == "Bullet")
-		{
-			fin >> m_bulletConfig.SR >> m_bulletConfig.CR >> m_bulletConfig.S >> m_bulletConfig.FR >> m_bulletConfig.FG >> m_bulletConfig.FB;
-			fin >> m_bulletConfig.OR >> m_bulletConfig.OG >> m_bulletConfig.OB >> m_bulletConfig.OT >> m_bulletConfig.V >> m_bulletConfig.L;
-		}
-		else
-		{
-			std::cerr << "File path '" << path << "' Object type '" << type << "' is unidentified!\n";
-			exit(-2);
-		}
-	}
-
-	
-	// set up window parameters
-	m_window.create(sf::VideoMode(m_windowConfig.W, m_windowConfig.H), "Shape Wars");
-	m_window.setFramerateLimit(m_windowConfig.FL);
-
-	spawnPlayer();
-}
-
-void Game::run()
-{
-	// TODO: add pause functionality in here
-	//		 some systems should function while paused (rendering)
-	//		 some system shouldn't (movement / input)
-	while (m_running)
-	{
-		m_entityManager.update();
-
-		if (!m_paused)
-		{
-			sEnemySpawner();	// if not paused these system should work
-			sMovement();
-			sCollision();
-			sLifespan();
-		}
-
-		sUserInput();			// only get input of pause key
-		sRender();				// even if paused this should still render the game
-
-		// increment the current frame
-		// may need to be moved when pause implemented
-		m_currentFrame++;
-	}
-}
-
-void Game::setPaused(bool paused)
-{
-	m_paused = paused;
-}
-
-// respawn the player in the middle of the screen
-void Game::spawnPlayer()
-{
-	// We create every entity by calling EntityManager.addEntity(tag)
-	// This returns a std::shared_ptr<Entity>, so we use "auto" to save typing
-	auto entity = m_entityManager.addEntity("player");
-
-	// Give this entity a Transform so it spawns at (x, y) with velocity (0, 0) and angle 0
-	float mx = m_window.getSize().x / 2.0f;
-	float my = m_window.getSize().y / 2.0f;
-
-	entity->cTransform = std::make_shared<CTransform>(Vec2(mx, my), Vec2(0.0f, 0.0f), 0.0f);
-
-	// The entity's shape will have radius , sides, fill, outline and thickness
-	entity->cShape = std::make_shared<CShape>(m_playerConfig.SR, m_playerConfig.V, sf::Color(m_playerConfig.FR, m_playerConfig.FG, m_playerConfig.FB),
-		sf::Color(m_playerConfig.OR, m_playerConfig.OG, m_playerConfig.OB), m_playerConfig.OT);
-
-	// Add an input component to the player so that we can use inputs
-	entity->cInput = std::make_shared<CInput>();
-
-	// Add a collision component to the player
-	entity->cCollision = std::make_shared<CCollision>(m_playerConfig.CR);
-
-	// Since we want this Entity to be our player, set our Game's player variable to be this Entity
-	// This goes slighty against the EntityManager paradigm, but we use the player so much it's worth it
-	m_player = entity;
-}
-
-// spawn an enemy at a random position
-void Game::spawnEnemy()
-{
-	// TODO: make sure the enemy is spawned properly with the m_enemyConfig variables
-	//		 the enemy must be spawned completely within the bounds of the window
-	//
-
-	auto entity = m_entityManager.addEntity("enemy");
-
-	// Give this entity a Transform so it spawns at (ex, ey) with velocity and angle 
-	float ex = m_enemyConfig.SR + (rand() % (1 + m_window.getSize().x - m_enemyConfig.SR));
-	float ey = m_enemyConfig.SR + (rand() % (1 + m_window.getSize().y - m_enemyConfig.SR));
-
-	// Give this entity  x and y velocity between SMIN and SMAX
-	float velX = (rand() % (1 + ((int)m_enemyConfig.SMAX * 2))) - m_enemyConfig.SMAX;
-	if (velX > (-m_enemyConfig.SMIN) && velX < 0)
-	{
-		velX -= m_enemyConfig.SMIN - 1 + (rand() % ((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN));
-	}
-	else if (velX < m_enemyConfig.SMIN && velX >= 0)
-	{
-		velX -= m_enemyConfig.SMIN + (rand() % ((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN - 1));
-	}
-	float velY = (rand() % (1 + ((int)m_enemyConfig.SMAX * 2))) - m_enemyConfig.SMAX;
-	if (velY > (-m_enemyConfig.SMIN) && velY < 0)
-	{
-		velY -= m_enemyConfig.SMIN - 1 + (rand() % ((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN));
-	}
-	else if (velY < m_enemyConfig.SMIN && velY >= 0)
-	{
-		velY -= m_enemyConfig.SMIN + (rand() % ((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN - 1));
-	}
-
-	entity->cTransform = std::make_shared<CTransform>(Vec2(ex, ey), Vec2(velX, velY));
-
-	//Give this entity a random vertices from VMIN to VMAX
-	int vertice = m_enemyConfig.VMIN + (rand() % (1 + m_enemyConfig.VMAX - m_enemyConfig.VMIN));
-
-	// The entity's shape will have radius, sides, fill, outline and thickness 
-	float r = rand() % 255, g = rand() % 255, b = rand() % 255;
-	entity->cShape = std::make_shared<CShape>(m_enemyConfig.SR, vertice, sf::Color(10, 10, 10), 
-		sf::Color(m_enemyConfig.OR, m_enemyConfig.OG, m_enemyConfig.OB), m_enemyConfig.OT);
-
-	// Add a collision component to the enemy
-	entity->cCollision = std::make_shared<CCollision>(m_enemyConfig.CR);
-
-	// Add a score component to the enemy
-	entity->cScore = std::make_shared<CScore>(vertice*100);
-
-	// record when the most recent enemy was spawned
-	m_lastEnemySpawnTime = m_currentFrame;
-}
-
-// spawns the small enemies when a big one (input entity e) explodes
-void Game::spawnSmallEnemies(std::shared_ptr<Entity> e)
-{
-	// TODO: spawn small enemies at the location of the input enemy e
-	// when we create the smaller enemy, we have to read the values of the original enemy
-	// - spawn a number of small enemies equal to the vertices of the original enemy
-	// - set each small enemy to the same color as the original, half the size
-	// - small enemies are worth double points of the original enemy
-
-	float magnitude = e->cTransform->velocity.length();
-	float angle = 0.0f;
-
-	for (int i = 0, vertice = e->cShape->circle.getPointCount(); i < vertice; i++)
-	{
-		auto entity = m_entityManager.addEntity("small-enemy");
-		float velX = magnitude * cos(angle);
-		float velY = magnitude * sin(angle);
-		entity->cTransform = std::make_shared<CTransform>(Vec2(e->cTransform->pos.x, e->cTransform->pos.y), Vec2(velX / 2, velY / 2), angle);
-		entity->cShape = std::make_shared<CShape>((e->cShape->circle.getRadius() / 2), vertice, sf::Color(e->cShape->circle.getFillColor()),
-			sf::Color(e->cShape->circle.getOutlineColor()), e->cShape->circle.getOutlineThickness());
-		entity->cCollision = std::make_shared<CCollision>((e->cCollision->radius / 2));
-		entity->cScore = std::make_shared<CScore>(e->cScore->score * 2);
-		entity->cLifespan = std::make_shared<CLifespan>(m_enemyConfig.L);
-		angle += (360.0 / (vertice));
-	}
-}
-
-// spawns a bullet from a given entity to a target location
-void Game::spawnBullet(std::shared_ptr<Entity> entity, const Vec2& target)
-{
-	// TODO: implement the spawning of a bullet which travels toward target
-	//		 - bullet speed is given as a scalar speed
-	//		 - you must set the velocity by using formula in notes
-
-	auto bullet = m_entityManager.addEntity("bullet");
-	Vec2 dist = entity->cTransform->pos.dist(target);
-	dist /= (dist.length());
-	dist *= (m_bulletConfig.S);
-
-	bullet->cTransform = std::make_shared<CTransform>(entity->cTransform->pos, dist);
-	bullet->cShape = std::make_shared<CShape>(m_bulletConfig.SR, m_bulletConfig.V, sf::Color(m_bulletConfig.FR, m_bulletConfig.FG,
-		m_bulletConfig.FB), sf::Color(m_bulletConfig.OR, m_bulletConfig.OG, m_bulletConfig.OB), m_bulletConfig.OT);
-	bullet->cCollision = std::make_shared<CCollision>(m_bulletConfig.CR);
-	bullet->cLifespan = std::make_shared<CLifespan>(m_bulletConfig.L);
-
-}
-
-void Game::spawnSpecialWeapon(std::shared_ptr<Entity> entity, const Vec2& target)
-{
-	// TODO: implement your own special weapon
-	if (m_currentFrame - m_lastSpecialTime >= m_bulletConfig.L * 5)
-	{
-		auto special = m_entityManager.addEntity("special");
-		Vec2 dist = entity->cTransform->pos.dist(target);
-		dist /= (dist.length());
-		dist *= 2;
-
-		special->cTransform = std::make_shared<CTransform>(entity->cTransform->pos, dist);
-		special->cShape = std::make_shared<CShape>(m_playerConfig.SR, m_playerConfig.V, sf::Color(200, 0,
-			0), sf::Color(255, 0, 0), m_bulletConfig.OT * 2);
-		special->cCollision = std::make_shared<CCollision>(m_playerConfig.CR);
-		special->cLifespan = std::make_shared<CLifespan>(m_bulletConfig.L * 5);
-		m_lastSpecialTime = m_currentFrame;
-	}
-}
-
-void Game::sMovement()
-{
-	// TODO: implement all entity movement in this function
-	//		 you should read the m_player->cInput component to determine if the player is moving
-	//		 implement player movement
-	if (m_player->cTransform->pos.y < m_playerConfig.SR)
-	{
-		m_player->cTransform->pos.y = m_playerConfig.SR + m_playerConfig.S;
-	}
-	else if (m_player->cTransform->pos.y > m_window.getSize().y - m_playerConfig.SR)
-	{
-		m_player->cTransform->pos.y = m_window.getSize().y - m_playerConfig.SR - m_playerConfig.S;
-	}
-	else
-	{
-		if (m_player->cInput->up)
-		{
-			m_player->cTransform->velocity.y = -m_playerConfig.S;
-		}
-		else if (m_player->cInput->down)
-		{
-			m_player->cTransform->velocity.y = m_playerConfig.S;
-		}
-		else { m_player->cTransform->velocity.y = 0.0f; }
-	}
-
-	if (m_player->cTransform->pos.x < m_playerConfig.SR)
-	{
-		m_player->cTransform->pos.x = m_playerConfig.SR + m_playerConfig.S;
-	}
-	else if (m_player->cTransform->pos.x > m_window.getSize().x - m_playerConfig.SR)
-	{
-		m_player->cTransform->pos.x = m_window.getSize().x - m_playerConfig.SR - m_playerConfig.S;
-	}
-	else
-	{
-		if (m_player->cInput->left)
-		{
-			m_player->cTransform->velocity.x = -m_playerConfig.S;
-		}
-		else if (m_player->cInput->right)
-		{
-			m_player->cTransform->velocity.x = m_playerConfig.S;
-		}
-		else { m_player->cTransform->velocity.x = 0.0f; }
-	}
-
-	// bounce enemies from window
-
-	for (auto& e : m_entityManager.getEntities("enemy"))
-	{
-		if (e->cTransform->pos.x < m_enemyConfig.SR || e->cTransform->pos.x > m_windowConfig.W - m_enemyConfig.SR)
-		{
-			e->cTransform->velocity.bounceX();
-		}
-		if (e->cTransform->pos.y < m_enemyConfig.SR || e->cTransform->pos.y > m_windowConfig.H - m_enemyConfig.SR)
-		{
-			e->cTransform->velocity.bounceY();
-		}
-	}
-
-	// movement update for entities
-	for (auto& e : m_entityManager.getEntities())
-	{
-		e->cTransform->pos.x += e->cTransform->velocity.x;
-		e->cTransform->pos.y += e->cTransform->velocity.y;
-	}
-}
-
-void Game::sLifespan()
-{
-
-	// TODO: implement all lifespan functionality
-	//
-	// for all entities
-	//	   if entity has no lifespan component, skip it
-	//	   if entity has > 0 remaining lifespan, subtract 1
-	//	   if it has lifespan and is alive
-	//			scale its alpha channel properly
-	//	   if it has lifespawn and its time is up
-	//			destroy the entity
-
-	for (auto& e : m_entityManager.getEntities())
-	{
-		if (!e->cLifespan)
-		{
-			continue;
-		}
-
-		if (e->cLifespan->remaining > 0)
-		{
-			e->cLifespan->remaining--;
-
-			float alpha = ((float)e->cLifespan->remaining / (float)e->cLifespan->total) * 255;
-
-			e->cShape->circle.setFillColor(sf::Color(e->cShape->circle.getFillColor().r, e->cShape->circle.getFillColor().g, 
-				e->cShape->circle.getFillColor().b, alpha));
-			e->cShape->circle.setOutlineColor(sf::Color(e->cShape->circle.getOutlineColor().r, e->cShape->circle.getOutlineColor().g,
-				e->cShape->circle.getOutlineColor().b, alpha));
-		}
-		else
-		{
-			e->destroy();
-		}
-	}
-}
-
-void Game::sCollision()
-{
-	// TODO: implement all proper collisions between entities
-	//		 be sure to use collision radius, NOT the shape radius
-
-	for (auto& e : m_entityManager.getEntities("enemy"))
-	{
-		for (auto& b : m_entityManager.getEntities("bullet"))
-		{
-			if (e->cTransform->pos.dist(b->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR))
-			{
-				m_score += e->cScore->score;
-				spawnSmallEnemies(e);
-				e->destroy();
-				b->destroy();
-			}
-		}
-		
-		if (m_player->cTransform->pos.dist(e->cTransform->pos).length() < (m_playerConfig.CR + m_enemyConfig.CR))
-		{
-			e->destroy();
-			m_player->cTransform->pos.x = m_window.getSize().x / 2.0f;
-			m_player->cTransform->pos.y = m_window.getSize().y / 2.0f;
-		}
-
-		for (auto& s : m_entityManager.getEntities("special"))
-		{
-			if (e->cTransform->pos.dist(s->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR))
-			{
-				m_score += e->cScore->score;
-				spawnSmallEnemies(e);
-				e->destroy();
-			}
-			else if (e->cTransform->pos.dist(s->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR) * 5)
-			{
-				Vec2 dist = e->cTransform->pos.dist(s->cTransform->pos);
-				e->cTransform->velocity = (dist / 50.0);
-				if (s->cLifespan->remaining == 0)
-				{
-					m_score += e->cScore->score;
-					spawnSmallEnemies(e);
-					e->destroy();
-				}
-			}
-
-		}
-	}
-
-	for (auto& b : m_entityManager.getEntities("bullet"))
-	{
-		for (auto& e : m_entityManager.getEntities("small-enemy"))
-		{
-			if (b->cTransform->pos.dist(e->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR))
-			{
-				m_score += e->cScore->score;
-				e->destroy();
-				b->destroy();
-			}
-		}
-	}
-}
-
-void Game::sEnemySpawner()
-{
-	// TODO: code which implements enemy spawning should go here
-	//
-	//		 (use m_currentFrame - m_lastEnemySpawnTime) to determine
-	//		 how long it has been since last enemy spawned
-	if (m_currentFrame - m_lastEnemySpawnTime >= m_enemyConfig.SI)
-	{
-		spawnEnemy();
-	}
-}
-
-void Game::sRender()
-{
-	// TODO: change the code below to draw ALL of the entities
-	//		 sample drawing of the player Entity that we have created
-	m_window.clear();
-
-	// set the position of the shape based on the entity's transform->pos
-	m_player->cShape->circle.setPosition(m_player->cTransform->pos.x, m_player->cTransform->pos.y);
-
-	// set the rotarion of the shape based on the entity's transform->angle
-	m_player->cTransform->angle += 1.0f;
-	m_player->cShape->circle.setRotation(m_player->cTransform->angle);
-
-	//draw the entity's sf::CircleShape
-	m_window.draw(m_player->cShape->circle);
-
-	for (auto& e : m_entityManager.getEntities())
-	{
-		// set the position of the shape based on the entity's transform->pos
-		e->cShape->circle.setPosition(e->cTransform->pos.x, e->cTransform->pos.y);
-
-		// set the rotarion of the shape based on the entity's transform->angle
-		e->cTransform->angle += 1.0f;
-		e->cShape->circle.setRotation(e->cTransform->angle);
-
-		//draw the entity's sf::CircleShape
-		m_window.draw(e->cShape->circle);
-	}
-
-	m_text.setString("Score : " + std::to_string(m_score));
-	m_window.draw(m_text);
-
-	m_window.display();
-}
-
-void Game::sUserInput()
-{
-	// TODO: handle user input here
-	//		 note that you should only be setting player's input component variables here
-	//		 you should not implement the player's movement logic here
-	//		 the movement system will read the variables you set in this function
-
-	sf::Event event;
-	while (m_window.pollEvent(event))
-	{
-		// this event triggers when window is closed
-		if (event.type == sf::Event::Closed)
-		{
-			m_running = false;
-		}
-
-		// this event is triggered when a key is pressed
-		if (event.type == sf::Event::KeyPressed)
-		{
-			switch (event.key.code)
-			{
-			case sf::Keyboard::W:
-				// set player's input component "up" to true
-				m_player->cInput->up = true;
-				break;
-			case sf::Keyboard::A:
-				// set player's input component "left" to true
-				m_player->cInput->left = true;
-				break;
-			case sf::Keyboard::S:
-				// set player's input component "down" to true
-				m_player->cInput->down = true;
-				break;
-			case sf::Keyboard::D:
-				// set player's input component "right" to true
-				m_player->cInput->right = true;
-				break;
-			case sf::Keyboard::Escape:
-				// Pause the game
-				if (!m_paused)
-				{
-					setPaused(true);
-					std::cout << "Game is paused\n";
-				}
-				else
-				{
-					setPaused(false);
-					std::cout << "Game is unpaused\n";
-				}
-				break;
-			default: break;
-			}
-		}
-
-		// this event is triggered when a key is released
-		if (event.type == sf::Event::KeyReleased)
-		{
-			switch (event.key.code)
-			{
-			case sf::Keyboard::W:
-				// TODO: set player's input component "up" to false
-				m_player->cInput->up = false;
-				break;
-			case sf::Keyboard::A:
-				// set player's input component "left" to false
-				m_player->cInput->left = false;
-				break;
-			case sf::Keyboard::S:
-				// set player's input component "down" to false
-				m_player->cInput->down = false;
-				break;
-			case sf::Keyboard::D:
-				// set player's input component "right" to false
-				m_player->cInput->right = false;
-				break;
-			default: break;
-			}
-		}
-
-		if (event.type == sf::Event::MouseButtonPressed && !m_paused)
-		{
-			if (event.mouseButton.button == sf::Mouse::Left)
-			{
-				spawnBullet(m_player, Vec2(event.mouseButton.x, event.mouseButton.y));
-			}
-
-			if (event.mouseButton.button == sf::Mouse::Right)
-			{
-				spawnSpecialWeapon(m_player, Vec2(event.mouseButton.x, event.mouseButton.y));
-			}
-		}
-	}
+#include "Game.hpp"
+#include "Trace.hpp"
+#include "Tags.hpp"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+Game::Game(const std::string& config)
+	: Game(config, GameMode::Play, std::random_device{}())
+{
+}
+
+Game::Game(const std::string& config, GameMode mode, unsigned int seed)
+	: m_mode(mode)
+	, m_headless(mode != GameMode::Play)
+	, m_rng(seed)
+{
+	init(config);
+
+	// a served game only has the players its clients add
+	if (m_mode != GameMode::Serve)
+	{
+		spawnPlayer();
+	}
+}
+
+void Game::init(const std::string& path)
+{
+	// a headless game never creates a window, SFML needs a display for one even before it is opened
+	if (!m_headless)
+	{
+		m_display = std::make_unique<Display>();
+	}
+
+	// Reads in config file
+	std::ifstream  fin(path);
+	std::string type, fontAdd;
+
+	while (fin >> type)
+	{
+		if (type == "Window")
+		{
+			fin >> m_windowConfig.W >> m_windowConfig.H >> m_windowConfig.FL >> m_windowConfig.FS;
+		}
+		else if (type == "Font")
+		{
+			fin >> fontAdd >> m_fontConfig.S >> m_fontConfig.R >> m_fontConfig.G >> m_fontConfig.B;
+
+			// nothing is drawn without a window, so don't load the font
+			if (m_headless)
+			{
+				continue;
+			}
+
+			// attempt to load the font from a file
+			if (!m_display->font.loadFromFile(fontAdd))
+			{
+				// if we can't load the font, let the caller decide whether to exit
+				throw std::runtime_error("Could not load font '" + fontAdd + "'");
+			}
+
+			m_display->text.setCharacterSize(m_fontConfig.S);
+			m_display->text.setFillColor(sf::Color(m_fontConfig.R, m_fontConfig.G, m_fontConfig.B));
+			m_display->text.setFont(m_display->font);
+		}
+		else if (type == "Player")
+		{
+			fin >> m_playerConfig.SR >> m_playerConfig.CR >> m_playerConfig.S >> m_playerConfig.FR >> m_playerConfig.FG >> m_playerConfig.FB;
+			fin >> m_playerConfig.OR >> m_playerConfig.OG >> m_playerConfig.OB >> m_playerConfig.OT >> m_playerConfig.V;
+		}
+		else if (type == "Enemy")
+		{
+			fin >> m_enemyConfig.SR >> m_enemyConfig.CR >> m_enemyConfig.SMIN >> m_enemyConfig.SMAX >> m_enemyConfig.OR >> m_enemyConfig.OG;
+			fin >> m_enemyConfig.OB >> m_enemyConfig.OT >> m_enemyConfig.VMIN >> m_enemyConfig.VMAX >> m_enemyConfig.L >> m_enemyConfig.SI;
+		}
+		else if (type == "Bullet")
+		{
+			fin >> m_bulletConfig.SR >> m_bulletConfig.CR >> m_bulletConfig.S >> m_bulletConfig.FR >> m_bulletConfig.FG >> m_bulletConfig.FB;
+			fin >> m_bulletConfig.OR >> m_bulletConfig.OG >> m_bulletConfig.OB >> m_bulletConfig.OT >> m_bulletConfig.V >> m_bulletConfig.L;
+		}
+		else if (type == "LOD")
+		{
+			fin >> m_lodConfig.OR >> m_lodConfig.OA >> m_lodConfig.PR >> m_lodConfig.PA >> m_lodConfig.RV;
+		}
+		else if (type == "Particle")
+		{
+			fin >> m_particleConfig.N >> m_particleConfig.S >> m_particleConfig.L;
+		}
+		else if (type == "Events")
+		{
+			fin >> m_eventConfig.F >> m_eventConfig.N;
+		}
+		else if (type == "Governor")
+		{
+			fin >> m_governorConfig.P >> m_governorConfig.U >> m_governorConfig.D >> m_governorConfig.M >> m_governorConfig.E;
+		}
+		else if (type == "Flock")
+		{
+			fin >> m_flockConfig.R >> m_flockConfig.S >> m_flockConfig.A >> m_flockConfig.C >> m_flockConfig.P >> m_flockConfig.M;
+		}
+		else if (type == "Locality")
+		{
+			fin >> m_localityConfig.P >> m_localityConfig.N;
+		}
+		else if (type == "Rewind")
+		{
+			fin >> m_rewindConfig.M >> m_rewindConfig.K;
+		}
+		else
+		{
+			throw std::runtime_error("File path '" + path + "' Object type '" + type + "' is unidentified!");
+		}
+	}
+
+	// set up window parameters, a headless game only simulates
+	if (!m_headless)
+	{
+		m_display->window.create(sf::VideoMode(m_windowConfig.W, m_windowConfig.H), "Shape Wars");
+		m_display->window.setFramerateLimit(m_windowConfig.FL);
+		m_display->lodBatch.setPrimitiveType(sf::Triangles);
+	}
+
+	m_field.resize(m_windowConfig.W, m_windowConfig.H, 32.0f);
+	if (m_flockConfig.R > 0.0f)
+	{
+		m_flockGrid.resize(m_windowConfig.W, m_windowConfig.H, std::max(1.0f, m_flockConfig.R));
+	}
+	m_entityManager.setSpatialOrder(m_localityConfig.P, m_localityConfig.N);
+	m_governor.init(m_governorConfig, m_windowConfig.FL);
+
+	// simulated games are for sweeps and tests, only a played or served game logs its events
+	if (m_mode != GameMode::Simulate && !m_eventConfig.F.empty() && !m_events.open(m_eventConfig.F, m_eventConfig.N))
+	{
+		std::cerr << "Could not open event log '" << m_eventConfig.F << "'\n";
+	}
+
+	// particles are only ever drawn, a headless game has no use for them
+	if (!m_headless)
+	{
+		m_particles.setCapacity(m_particleConfig.N);
+		m_rewind.init((size_t)std::max(0, m_rewindConfig.M) * 1024, m_rewindConfig.K);
+	}
+
+	// workers get the cores the game's own threads leave free, a played game also has a render
+	// thread, simulated games are run many at a time by the BatchRunner and keep to one thread each
+	unsigned int cores = std::thread::hardware_concurrency();
+	if (m_mode == GameMode::Play)
+	{
+		m_workers.start(cores > 2 ? cores - 2 : 0);
+	}
+	else if (m_mode == GameMode::Serve)
+	{
+		m_workers.start(cores > 1 ? cores - 1 : 0);
+	}
+}
+
+void Game::run()
+{
+	// TODO: add pause functionality in here
+	//		 some systems should function while paused (rendering)
+	//		 some system shouldn't (movement / input)
+
+	// the render thread draws the last published state while this thread takes input and simulates the next one
+	// a window can only be drawn to from the thread it is active on, so it is handed over
+	m_display->window.setActive(false);
+	std::thread renderThread(&Game::renderLoop, this);
+
+	// display() no longer paces this thread, so it sleeps off what is left of each frame itself
+	auto tick = std::chrono::microseconds(m_windowConfig.FL > 0 ? 1000000 / m_windowConfig.FL : 0);
+	auto nextTick = std::chrono::steady_clock::now();
+
+	while (m_running)
+	{
+		TRACE_ZONE("frame");
+		m_frameClock.restart();
+
+		step();					// if not paused the game logic should work
+
+		sUserInput();			// only get input of pause key
+		sRender();				// even if paused this should still render the game
+
+		// the governor sees whichever thread is slower, the simulation or drawing the last state
+		m_workTime = m_frameClock.getElapsedTime();
+		m_governor.update(std::max((float)m_workTime.asMicroseconds(), (float)m_renderMicros), m_currentFrame);
+
+		// a frame that ran late starts the next one right away instead of trying to catch up
+		TRACE_ZONE("wait");
+		nextTick = std::max(nextTick + tick, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(nextTick);
+	}
+
+	m_display->states.close();
+	renderThread.join();
+	m_display->window.setActive(true);
+
+	if (Trace::isEnabled())
+	{
+		Trace::save("trace.json");
+	}
+}
+
+// runs the game logic for a number of ticks with the bot as the player, nothing is drawn
+void Game::simulate(int ticks)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < ticks; i++)
+	{
+		TRACE_ZONE("tick");
+
+		step();
+		m_stats.peakEntities = std::max(m_stats.peakEntities, (int)m_entityManager.getEntities().size());
+	}
+
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+	m_stats.ticks += ticks;
+	m_stats.tickMicros = ticks > 0 ? elapsed.count() / ticks : 0.0;
+	m_stats.score = m_score;
+	if (m_stats.deaths == 0)
+	{
+		m_stats.survivalTicks = m_currentFrame;
+	}
+}
+
+void Game::step()
+{
+	TRACE_ZONE("Game::step");
+
+	m_entityManager.update();
+	traceCounters();
+
+	// only a played game is ever paused
+	if (!m_paused)
+	{
+		// in a simulated game the bot takes the place of the keyboard
+		if (m_mode == GameMode::Simulate)
+		{
+			sBot();
+		}
+
+		sEnemySpawner();
+		sField();
+		sFlock();
+		sMovement();
+		sCollision();
+		sLifespan();
+
+		// both only matter to a game that is drawn
+		if (!m_headless)
+		{
+			sParticles();
+			sRewind();
+		}
+
+		// frames count game time, so spawn intervals and cooldowns don't run out while paused
+		m_currentFrame++;
+	}
+}
+
+int Game::currentFrame() const
+{
+	return m_currentFrame;
+}
+
+int Game::frameLimit() const
+{
+	return m_windowConfig.FL;
+}
+
+int Game::score() const
+{
+	return m_score;
+}
+
+const EntityVec& Game::entities()
+{
+	return m_entityManager.getEntities();
+}
+
+EnemyConfig& Game::enemyConfig()
+{
+	return m_enemyConfig;
+}
+
+BulletConfig& Game::bulletConfig()
+{
+	return m_bulletConfig;
+}
+
+const GameStats& Game::stats() const
+{
+	return m_stats;
+}
+
+// returns a random number in [0, max), like rand() % max but owned by this game
+int Game::random(int max)
+{
+	if (max <= 0)
+	{
+		return 0;
+	}
+	return (int)(m_rng() % (unsigned int)max);
+}
+
+// appends a gameplay event to the event log, other is whoever caused it
+void Game::logEvent(EventType type, const std::shared_ptr<Entity>& e, const std::shared_ptr<Entity>& other, int value)
+{
+	if (!m_events.isOpen())
+	{
+		return;
+	}
+
+	EventRecord r;
+	r.tick		= m_currentFrame;
+	r.type		= type;
+	r.tag		= tagId(e->tag());
+	r.otherTag	= other ? tagId(other->tag()) : 0;
+	r.padding	= 0;
+	r.entity	= (uint32_t)e->id();
+	r.other		= other ? (uint32_t)other->id() : 0;
+	r.value		= value;
+	r.x			= e->cTransform->pos.x;
+	r.y			= e->cTransform->pos.y;
+	m_events.write(r);
+}
+
+// entity counts per tag for the trace timeline
+void Game::traceCounters()
+{
+	// counter names are kept by the trace until it is saved, so they have to be literals
+	static const char* tags[] = { "player", "enemy", "small-enemy", "bullet", "special" };
+
+	if (!Trace::isEnabled())
+	{
+		return;
+	}
+
+	TRACE_COUNTER("entities", (int64_t)m_entityManager.getEntities().size());
+	for (const char* tag : tags)
+	{
+		TRACE_COUNTER(tag, (int64_t)m_entityManager.getEntities(tag).size());
+	}
+}
+
+void Game::setPaused(bool paused)
+{
+	m_paused = paused;
+
+	// unpausing goes back to the live game, stepping back only ever shows what was recorded
+	if (!paused)
+	{
+		m_rewindStep = 0;
+	}
+}
+
+void Game::stepRewind(int frames)
+{
+	if (!m_paused || m_rewind.frames() == 0)
+	{
+		return;
+	}
+
+	m_rewindStep = std::max(0, std::min((int)m_rewind.frames() - 1, m_rewindStep + frames));
+	if (m_rewindStep > 0)
+	{
+		m_rewind.seek(m_rewind.tick(m_rewind.frames() - 1 - m_rewindStep), m_rewindWorld);
+	}
+}
+
+// respawn the player in the middle of the screen
+void Game::spawnPlayer()
+{
+	// Since we want this Entity to be our player, set our Game's player variable to be this Entity
+	// This goes slighty against the EntityManager paradigm, but we use the player so much it's worth it
+	m_player = addPlayer();
+}
+
+// add a player entity in the middle of the screen, every connected client of a Server gets one
+std::shared_ptr<Entity> Game::addPlayer()
+{
+	// We create every entity by calling EntityManager.addEntity(tag)
+	// This returns a std::shared_ptr<Entity>, so we use "auto" to save typing
+	auto entity = m_entityManager.addEntity("player");
+
+	// Give this entity a Transform so it spawns at (x, y) with velocity (0, 0) and angle 0
+	float mx = m_windowConfig.W / 2.0f;
+	float my = m_windowConfig.H / 2.0f;
+
+	entity->cTransform = std::make_shared<CTransform>(Vec2(mx, my), Vec2(0.0f, 0.0f), 0.0f);
+
+	// The entity's shape will have radius , sides, fill, outline and thickness
+	entity->cShape = std::make_shared<CShape>(m_playerConfig.SR, m_playerConfig.V, sf::Color(m_playerConfig.FR, m_playerConfig.FG, m_playerConfig.FB),
+		sf::Color(m_playerConfig.OR, m_playerConfig.OG, m_playerConfig.OB), m_playerConfig.OT);
+
+	// Add an input component to the player so that we can use inputs
+	entity->cInput = std::make_shared<CInput>();
+
+	// every player waits for its own special weapon, not for the other players', a new one waits a whole cooldown
+	entity->cCooldown = std::make_shared<CCooldown>();
+	entity->cCooldown->special = m_currentFrame + m_bulletConfig.L * 5;
+
+	// Add a collision component to the player
+	entity->cCollision = std::make_shared<CCollision>(m_playerConfig.CR);
+
+	logEvent(EVENT_SPAWN, entity);
+	return entity;
+}
+
+// spawn an enemy at a random position
+void Game::spawnEnemy()
+{
+	// TODO: make sure the enemy is spawned properly with the m_enemyConfig variables
+	//		 the enemy must be spawned completely within the bounds of the window
+	//
+
+	auto entity = m_entityManager.addEntity("enemy");
+
+	// Give this entity a Transform so it spawns at (ex, ey) with velocity and angle 
+	float ex = m_enemyConfig.SR + random(1 + m_windowConfig.W - m_enemyConfig.SR);
+	float ey = m_enemyConfig.SR + random(1 + m_windowConfig.H - m_enemyConfig.SR);
+
+	// Give this entity  x and y velocity between SMIN and SMAX
+	float velX = random(1 + ((int)m_enemyConfig.SMAX * 2)) - m_enemyConfig.SMAX;
+	if (velX > (-m_enemyConfig.SMIN) && velX < 0)
+	{
+		velX -= m_enemyConfig.SMIN - 1 + random((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN);
+	}
+	else if (velX < m_enemyConfig.SMIN && velX >= 0)
+	{
+		velX -= m_enemyConfig.SMIN + random((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN - 1);
+	}
+	float velY = random(1 + ((int)m_enemyConfig.SMAX * 2)) - m_enemyConfig.SMAX;
+	if (velY > (-m_enemyConfig.SMIN) && velY < 0)
+	{
+		velY -= m_enemyConfig.SMIN - 1 + random((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN);
+	}
+	else if (velY < m_enemyConfig.SMIN && velY >= 0)
+	{
+		velY -= m_enemyConfig.SMIN + random((int)m_enemyConfig.SMAX - (int)m_enemyConfig.SMIN - 1);
+	}
+
+	entity->cTransform = std::make_shared<CTransform>(Vec2(ex, ey), Vec2(velX, velY));
+
+	//Give this entity a random vertices from VMIN to VMAX
+	int vertice = m_enemyConfig.VMIN + random(1 + m_enemyConfig.VMAX - m_enemyConfig.VMIN);
+
+	// The entity's shape will have radius, sides, fill, outline and thickness 
+	float r = random(255), g = random(255), b = random(255);
+	entity->cShape = std::make_shared<CShape>(m_enemyConfig.SR, vertice, sf::Color(10, 10, 10), 
+		sf::Color(m_enemyConfig.OR, m_enemyConfig.OG, m_enemyConfig.OB), m_enemyConfig.OT);
+
+	// Add a collision component to the enemy
+	entity->cCollision = std::make_shared<CCollision>(m_enemyConfig.CR);
+
+	// Add a score component to the enemy
+	entity->cScore = std::make_shared<CScore>(vertice*100);
+
+	// big enemies flock, see sFlock
+	entity->cSteering = std::make_shared<CSteering>();
+
+	// record when the most recent enemy was spawned
+	m_lastEnemySpawnTime = m_currentFrame;
+	logEvent(EVENT_SPAWN, entity);
+}
+
+// spawns the small enemies when a big one (input entity e) explodes
+void Game::spawnSmallEnemies(std::shared_ptr<Entity> e)
+{
+	// TODO: spawn small enemies at the location of the input enemy e
+	// when we create the smaller enemy, we have to read the values of the original enemy
+	// - spawn a number of small enemies equal to the vertices of the original enemy
+	// - set each small enemy to the same color as the original, half the size
+	// - small enemies are worth double points of the original enemy
+
+	float magnitude = e->cTransform->velocity.length();
+	float angle = 0.0f;
+
+	for (int i = 0, vertice = e->cShape->circle.getPointCount(); i < vertice; i++)
+	{
+		auto entity = m_entityManager.addEntity("small-enemy");
+		float velX = magnitude * cos(angle);
+		float velY = magnitude * sin(angle);
+		entity->cTransform = std::make_shared<CTransform>(Vec2(e->cTransform->pos.x, e->cTransform->pos.y), Vec2(velX / 2, velY / 2), angle);
+		entity->cShape = std::make_shared<CShape>((e->cShape->circle.getRadius() / 2), vertice, sf::Color(e->cShape->circle.getFillColor()),
+			sf::Color(e->cShape->circle.getOutlineColor()), e->cShape->circle.getOutlineThickness());
+		entity->cCollision = std::make_shared<CCollision>((e->cCollision->radius / 2));
+		entity->cScore = std::make_shared<CScore>(e->cScore->score * 2);
+		entity->cLifespan = std::make_shared<CLifespan>(m_enemyConfig.L);
+		logEvent(EVENT_SPAWN, entity, e);
+		angle += (360.0 / (vertice));
+	}
+}
+
+// throws sparks in the colour of a dying entity, purely cosmetic
+void Game::spawnExplosion(std::shared_ptr<Entity> e)
+{
+	if (m_headless || m_governor.active(MEASURE_COSMETIC))
+	{
+		return;
+	}
+
+	m_particles.burst(e->cTransform->pos, m_particleConfig.S, 6.0f, 2.0f, m_particleConfig.L, e->cShape->circle.getOutlineColor());
+}
+
+// spawns a bullet from a given entity to a target location
+void Game::spawnBullet(std::shared_ptr<Entity> entity, const Vec2& target)
+{
+	// TODO: implement the spawning of a bullet which travels toward target
+	//		 - bullet speed is given as a scalar speed
+	//		 - you must set the velocity by using formula in notes
+
+	auto bullet = m_entityManager.addEntity("bullet");
+	Vec2 dist = entity->cTransform->pos.dist(target);
+	dist /= (dist.length());
+	dist *= (m_bulletConfig.S);
+
+	bullet->cTransform = std::make_shared<CTransform>(entity->cTransform->pos, dist);
+	bullet->cShape = std::make_shared<CShape>(m_bulletConfig.SR, m_bulletConfig.V, sf::Color(m_bulletConfig.FR, m_bulletConfig.FG,
+		m_bulletConfig.FB), sf::Color(m_bulletConfig.OR, m_bulletConfig.OG, m_bulletConfig.OB), m_bulletConfig.OT);
+	bullet->cCollision = std::make_shared<CCollision>(m_bulletConfig.CR);
+	bullet->cLifespan = std::make_shared<CLifespan>(m_bulletConfig.L);
+	logEvent(EVENT_SPAWN, bullet, entity);
+
+}
+
+void Game::spawnSpecialWeapon(std::shared_ptr<Entity> entity, const Vec2& target)
+{
+	// TODO: implement your own special weapon
+	if (entity->cCooldown && m_currentFrame >= entity->cCooldown->special)
+	{
+		auto special = m_entityManager.addEntity("special");
+		Vec2 dist = entity->cTransform->pos.dist(target);
+		dist /= (dist.length());
+		dist *= 2;
+
+		special->cTransform = std::make_shared<CTransform>(entity->cTransform->pos, dist);
+		special->cShape = std::make_shared<CShape>(m_playerConfig.SR, m_playerConfig.V, sf::Color(200, 0,
+			0), sf::Color(255, 0, 0), m_bulletConfig.OT * 2);
+		special->cCollision = std::make_shared<CCollision>(m_playerConfig.CR);
+		special->cLifespan = std::make_shared<CLifespan>(m_bulletConfig.L * 5);
+
+		// the special pulls every enemy within five times the collision range towards itself
+		special->cEmitter = std::make_shared<CEmitter>((m_bulletConfig.CR + m_enemyConfig.CR) * 5, 1.0f / 50.0f);
+		entity->cCooldown->special = m_currentFrame + m_bulletConfig.L * 5;
+		logEvent(EVENT_SPECIAL, special, entity);
+	}
+}
+
+void Game::sMovement()
+{
+	TRACE_ZONE("Game::sMovement");
+
+	// TODO: implement all entity movement in this function
+	//		 you should read the m_player->cInput component to determine if the player is moving
+	//		 implement player movement
+
+	// every player entity moves from its own input component, there is one per client on a Server
+	for (auto& p : m_entityManager.getEntities("player"))
+	{
+		if (p->cTransform->pos.y < m_playerConfig.SR)
+		{
+			p->cTransform->pos.y = m_playerConfig.SR + m_playerConfig.S;
+		}
+		else if (p->cTransform->pos.y > m_windowConfig.H - m_playerConfig.SR)
+		{
+			p->cTransform->pos.y = m_windowConfig.H - m_playerConfig.SR - m_playerConfig.S;
+		}
+		else
+		{
+			if (p->cInput->up)
+			{
+				p->cTransform->velocity.y = -m_playerConfig.S;
+			}
+			else if (p->cInput->down)
+			{
+				p->cTransform->velocity.y = m_playerConfig.S;
+			}
+			else { p->cTransform->velocity.y = 0.0f; }
+		}
+
+		if (p->cTransform->pos.x < m_playerConfig.SR)
+		{
+			p->cTransform->pos.x = m_playerConfig.SR + m_playerConfig.S;
+		}
+		else if (p->cTransform->pos.x > m_windowConfig.W - m_playerConfig.SR)
+		{
+			p->cTransform->pos.x = m_windowConfig.W - m_playerConfig.SR - m_playerConfig.S;
+		}
+		else
+		{
+			if (p->cInput->left)
+			{
+				p->cTransform->velocity.x = -m_playerConfig.S;
+			}
+			else if (p->cInput->right)
+			{
+				p->cTransform->velocity.x = m_playerConfig.S;
+			}
+			else { p->cTransform->velocity.x = 0.0f; }
+		}
+	}
+
+	// bounce enemies from window
+
+	for (auto& e : m_entityManager.getEntities("enemy"))
+	{
+		if (e->cTransform->pos.x < m_enemyConfig.SR || e->cTransform->pos.x > m_windowConfig.W - m_enemyConfig.SR)
+		{
+			e->cTransform->velocity.bounceX();
+		}
+		if (e->cTransform->pos.y < m_enemyConfig.SR || e->cTransform->pos.y > m_windowConfig.H - m_enemyConfig.SR)
+		{
+			e->cTransform->velocity.bounceY();
+		}
+	}
+
+	// enemies are steered by the force field, blending towards its pull instead of snapping to it
+	for (auto& e : m_entityManager.getEntities("enemy"))
+	{
+		e->cTransform->velocity = m_field.apply(e->cTransform->pos, e->cTransform->velocity, 0.2f);
+	}
+
+	// movement update for entities, every shape also spins a degree per frame
+	for (auto& e : m_entityManager.getEntities())
+	{
+		e->cTransform->pos.x += e->cTransform->velocity.x;
+		e->cTransform->pos.y += e->cTransform->velocity.y;
+		e->cTransform->angle += 1.0f;
+	}
+}
+
+void Game::sLifespan()
+{
+	TRACE_ZONE("Game::sLifespan");
+
+	// TODO: implement all lifespan functionality
+	//
+	// for all entities
+	//	   if entity has no lifespan component, skip it
+	//	   if entity has > 0 remaining lifespan, subtract 1
+	//	   if it has lifespan and is alive
+	//			scale its alpha channel properly
+	//	   if it has lifespawn and its time is up
+	//			destroy the entity
+
+	for (auto& e : m_entityManager.getEntities())
+	{
+		if (!e->cLifespan)
+		{
+			continue;
+		}
+
+		if (e->cLifespan->remaining > 0)
+		{
+			e->cLifespan->remaining--;
+
+			// under load each entity's alpha is only set every other frame, half of them each frame
+			if (m_governor.active(MEASURE_FADES) && (e->id() + m_currentFrame) % 2 != 0)
+			{
+				continue;
+			}
+
+			float alpha = ((float)e->cLifespan->remaining / (float)e->cLifespan->total) * 255;
+
+			e->cShape->circle.setFillColor(sf::Color(e->cShape->circle.getFillColor().r, e->cShape->circle.getFillColor().g, 
+				e->cShape->circle.getFillColor().b, alpha));
+			e->cShape->circle.setOutlineColor(sf::Color(e->cShape->circle.getOutlineColor().r, e->cShape->circle.getOutlineColor().g,
+				e->cShape->circle.getOutlineColor().b, alpha));
+		}
+		else
+		{
+			e->destroy();
+		}
+	}
+}
+
+void Game::sCollision()
+{
+	TRACE_ZONE("Game::sCollision");
+
+	int64_t pairs = 0;	// collision pairs tested, for the trace
+
+	// TODO: implement all proper collisions between entities
+	//		 be sure to use collision radius, NOT the shape radius
+
+	for (auto& e : m_entityManager.getEntities("enemy"))
+	{
+		for (auto& b : m_entityManager.getEntities("bullet"))
+		{
+			pairs++;
+			if (e->cTransform->pos.dist(b->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR))
+			{
+				m_score += e->cScore->score;
+				logEvent(EVENT_KILL, e, b, e->cScore->score);
+				spawnSmallEnemies(e);
+				spawnExplosion(e);
+				e->destroy();
+				b->destroy();
+			}
+		}
+		
+		for (auto& p : m_entityManager.getEntities("player"))
+		{
+			pairs++;
+			if (p->cTransform->pos.dist(e->cTransform->pos).length() < (m_playerConfig.CR + m_enemyConfig.CR))
+			{
+				logEvent(EVENT_KILL, e, p);
+				logEvent(EVENT_DEATH, p, e);
+				spawnExplosion(e);
+				e->destroy();
+				p->cTransform->pos.x = m_windowConfig.W / 2.0f;
+				p->cTransform->pos.y = m_windowConfig.H / 2.0f;
+				logEvent(EVENT_RESPAWN, p);
+
+				// the first death ends the player's survival time
+				if (m_stats.deaths++ == 0)
+				{
+					m_stats.survivalTicks = m_currentFrame;
+				}
+			}
+		}
+
+		// the pull of the special is done by the force field, here it only hits or detonates
+		for (auto& s : m_entityManager.getEntities("special"))
+		{
+			pairs++;
+			float d = e->cTransform->pos.dist(s->cTransform->pos).length();
+			bool detonated = s->cLifespan->remaining == 0 && d < s->cEmitter->radius;
+
+			if (d < (m_bulletConfig.CR + m_enemyConfig.CR) || detonated)
+			{
+				m_score += e->cScore->score;
+				logEvent(EVENT_KILL, e, s, e->cScore->score);
+				spawnSmallEnemies(e);
+				spawnExplosion(e);
+				e->destroy();
+			}
+		}
+	}
+
+	for (auto& b : m_entityManager.getEntities("bullet"))
+	{
+		for (auto& e : m_entityManager.getEntities("small-enemy"))
+		{
+			pairs++;
+			if (b->cTransform->pos.dist(e->cTransform->pos).length() < (m_bulletConfig.CR + m_enemyConfig.CR))
+			{
+				m_score += e->cScore->score;
+				logEvent(EVENT_KILL, e, b, e->cScore->score);
+				spawnExplosion(e);
+				e->destroy();
+				b->destroy();
+			}
+		}
+	}
+
+	TRACE_COUNTER("collision pairs", pairs);
+}
+
+void Game::sBot()
+{
+	TRACE_ZONE("Game::sBot");
+
+	// a simple stand-in for the user: keep away from the nearest enemy and shoot at it
+
+	std::shared_ptr<Entity> nearest;
+	float nearestDist = 0.0f;
+
+	for (auto& tag : { "enemy", "small-enemy" })
+	{
+		for (auto& e : m_entityManager.getEntities(tag))
+		{
+			float d = m_player->cTransform->pos.dist(e->cTransform->pos).length();
+			if (!nearest || d < nearestDist)
+			{
+				nearest = e;
+				nearestDist = d;
+			}
+		}
+	}
+
+	*m_player->cInput = CInput();
+
+	if (!nearest)
+	{
+		return;
+	}
+
+	Vec2 away = nearest->cTransform->pos.dist(m_player->cTransform->pos);
+	if (nearestDist < m_playerConfig.CR * 6)
+	{
+		m_player->cInput->left	= away.x < 0;
+		m_player->cInput->right	= away.x > 0;
+		m_player->cInput->up	= away.y < 0;
+		m_player->cInput->down	= away.y > 0;
+	}
+
+	if (m_currentFrame % 10 == 0 && nearestDist > 0.0f)
+	{
+		spawnBullet(m_player, nearest->cTransform->pos);
+	}
+
+	if (nearest->tag() == "enemy" && nearestDist > 0.0f)
+	{
+		spawnSpecialWeapon(m_player, nearest->cTransform->pos);
+	}
+}
+
+void Game::sField()
+{
+	TRACE_ZONE("Game::sField");
+
+	// every emitter writes into the force field, which movement then samples once per entity
+	m_field.clear();
+
+	for (auto& e : m_entityManager.getEntities())
+	{
+		if (e->cEmitter)
+		{
+			m_field.addEmitter(e->cTransform->pos, e->cEmitter->radius, e->cEmitter->strength);
+		}
+	}
+}
+
+void Game::sFlock()
+{
+	TRACE_ZONE("Game::sFlock");
+
+	// off unless a Flock line gave it a neighbour radius
+	if (m_flockConfig.R <= 0.0f)
+	{
+		return;
+	}
+
+	// enemies steer away from close neighbours, along with and towards the others, and after the nearest player
+	// each enemy reads only what is gathered here and writes only its own force, so chunks can run on any thread
+	const auto& enemies = m_entityManager.getEntities("enemy");
+	const auto& players = m_entityManager.getEntities("player");
+	const FlockConfig& c = m_flockConfig;
+
+	m_flockPos.resize(enemies.size());
+	m_flockVel.resize(enemies.size());
+	for (size_t i = 0; i < enemies.size(); i++)
+	{
+		m_flockPos[i] = enemies[i]->cTransform->pos;
+		m_flockVel[i] = enemies[i]->cTransform->velocity;
+	}
+
+	// neighbours are only looked for in the cells around an enemy instead of among all of them
+	m_flockGrid.build(m_flockPos);
+
+	m_workers.parallelFor(enemies.size(), 256, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			if (!enemies[i]->cSteering)
+			{
+				continue;
+			}
+
+			const Vec2 pos = m_flockPos[i];
+			const Vec2 vel = m_flockVel[i];
+			Vec2 force;
+
+			// this runs for every candidate pair, so it sticks to plain floats and local copies the compiler can keep in registers
+			const Vec2* positions = m_flockPos.data();
+			const Vec2* velocities = m_flockVel.data();
+			const float radius = c.R;
+			float sx = 0.0f, sy = 0.0f, hx = 0.0f, hy = 0.0f, cx = 0.0f, cy = 0.0f;
+			int neighbours = 0;
+
+			// a tight clump could have hundreds in range, 32 of them are plenty to steer by
+			m_flockGrid.forEachNear(pos, [&](int j)
+			{
+				const Vec2& other = positions[j];
+				float ax = pos.x - other.x, ay = pos.y - other.y;
+				float d2 = ax * ax + ay * ay;
+				if (j == (int)i || d2 >= radius * radius)
+				{
+					return true;
+				}
+
+				// pushed harder the closer the neighbour is
+				float d = std::sqrt(d2);
+				if (d > 0.0f)
+				{
+					float push = (1.0f - d / radius) / d;
+					sx += ax * push;
+					sy += ay * push;
+				}
+				hx += velocities[j].x;
+				hy += velocities[j].y;
+				cx += other.x;
+				cy += other.y;
+				return ++neighbours < 32;
+			});
+
+			if (neighbours > 0)
+			{
+				float n = (float)neighbours;
+				force += Vec2(sx, sy) * c.S;
+				force += Vec2(hx / n - vel.x, hy / n - vel.y) * c.A;
+				force += Vec2(cx / n - pos.x, cy / n - pos.y) * (c.C / std::max(1.0f, c.R));
+			}
+
+			// head for where the nearest player will be by the time it is reached
+			std::shared_ptr<Entity> target;
+			float targetDist = 0.0f;
+			for (auto& p : players)
+			{
+				float d = pos.dist(p->cTransform->pos).length();
+				if (!target || d < targetDist)
+				{
+					target = p;
+					targetDist = d;
+				}
+			}
+
+			if (target && targetDist > 0.0f)
+			{
+				float lead = std::min(targetDist / m_enemyConfig.SMAX, 30.0f);
+				Vec2 to = pos.dist(target->cTransform->pos + target->cTransform->velocity * lead);
+				float d = to.length();
+				if (d > 0.0f)
+				{
+					force += (to * (m_enemyConfig.SMAX / d) - vel) * c.P;
+				}
+			}
+
+			float f = force.length();
+			if (f > c.M)
+			{
+				force *= c.M / f;
+			}
+			enemies[i]->cSteering->force = force;
+		}
+	});
+
+	// steering only turns an enemy, it keeps the speed it was spawned with
+	for (auto& e : enemies)
+	{
+		if (!e->cSteering)
+		{
+			continue;
+		}
+
+		Vec2& velocity = e->cTransform->velocity;
+		float speed = velocity.length();
+		Vec2 turned = velocity + e->cSteering->force;
+		float length = turned.length();
+		if (length > 0.0f)
+		{
+			velocity = turned * (speed / length);
+		}
+	}
+}
+
+void Game::sRewind()
+{
+	// a no-op unless a Rewind line gave it memory, headless games never do
+	m_rewind.record((uint32_t)m_currentFrame, m_entityManager.getEntities());
+}
+
+void Game::sParticles()
+{
+	TRACE_ZONE("Game::sParticles");
+
+	// effects that don't alter game play: bullet trails and the glow of the special weapon
+	// under load the governor stops new particles, the ones alive still fade out
+
+	if (!m_governor.active(MEASURE_COSMETIC))
+	{
+		for (auto& b : m_entityManager.getEntities("bullet"))
+		{
+			m_particles.emit(b->cTransform->pos, Vec2(0.0f, 0.0f), 2.0f, 10, b->cShape->circle.getFillColor());
+		}
+
+		for (auto& s : m_entityManager.getEntities("special"))
+		{
+			m_particles.burst(s->cTransform->pos, 4, 2.0f, 3.0f, 20, sf::Color(255, 60, 0));
+		}
+	}
+
+	m_particles.update();
+}
+
+void Game::sEnemySpawner()
+{
+	TRACE_ZONE("Game::sEnemySpawner");
+
+	// TODO: code which implements enemy spawning should go here
+	//
+	//		 (use m_currentFrame - m_lastEnemySpawnTime) to determine
+	//		 how long it has been since last enemy spawned
+	// under load the governor spawns half as often, then stops spawning above its enemy cap
+	int interval = m_governor.active(MEASURE_THROTTLE) ? m_enemyConfig.SI * 2 : m_enemyConfig.SI;
+	bool capped = m_governor.active(MEASURE_CAP) &&
+		(int)(m_entityManager.getEntities("enemy").size() + m_entityManager.getEntities("small-enemy").size()) >= m_governor.enemyCap();
+
+	if (m_currentFrame - m_lastEnemySpawnTime >= interval && !capped)
+	{
+		spawnEnemy();
+	}
+}
+
+// appends a filled regular polygon to a triangle batch, laid out like the points of an sf::CircleShape
+// triangulated from its first point, so it takes 3 * (points - 2) vertices and no centre
+static void appendPolygon(sf::VertexArray& batch, const Vec2& pos, float radius, size_t points, float angle, const sf::Color& color)
+{
+	const float pi = 3.14159265f;
+	auto corner = [&](size_t i)
+	{
+		float a = i * 2 * pi / points - pi / 2 + angle * pi / 180.0f;
+		return sf::Vector2f(pos.x + radius * cos(a), pos.y + radius * sin(a));
+	};
+
+	const sf::Vector2f first = corner(0);
+	sf::Vector2f previous = corner(1);
+
+	for (size_t i = 2; i < points; i++)
+	{
+		sf::Vector2f point = corner(i);
+		batch.append(sf::Vertex(first, color));
+		batch.append(sf::Vertex(previous, color));
+		batch.append(sf::Vertex(point, color));
+		previous = point;
+	}
+}
+
+// appends an axis aligned square (two triangles) to a triangle batch
+static void appendPoint(sf::VertexArray& batch, const Vec2& pos, float halfSize, const sf::Color& color)
+{
+	sf::Vector2f tl(pos.x - halfSize, pos.y - halfSize), tr(pos.x + halfSize, pos.y - halfSize);
+	sf::Vector2f bl(pos.x - halfSize, pos.y + halfSize), br(pos.x + halfSize, pos.y + halfSize);
+
+	batch.append(sf::Vertex(tl, color));
+	batch.append(sf::Vertex(tr, color));
+	batch.append(sf::Vertex(br, color));
+	batch.append(sf::Vertex(tl, color));
+	batch.append(sf::Vertex(br, color));
+	batch.append(sf::Vertex(bl, color));
+}
+
+// small or faded shapes lose most of their vertices, tiny or nearly invisible ones become points
+LOD Game::levelOfDetail(const RenderShape& s, bool reducedDetail) const
+{
+	float radius = s.radius;
+	int alpha = s.fill.a;
+
+	// under load the governor doubles every threshold, so more entities are drawn cheaply
+	// with the default alpha threshold that reduces every shape, none keeps its outline
+	if (reducedDetail)
+	{
+		radius /= 2;
+		alpha /= 2;
+	}
+
+	if (radius < m_lodConfig.PR || alpha < m_lodConfig.PA)
+	{
+		return LOD::Point;
+	}
+	if (radius < m_lodConfig.OR || alpha < m_lodConfig.OA)
+	{
+		return LOD::Reduced;
+	}
+	return LOD::Full;
+}
+
+void Game::sRender()
+{
+	TRACE_ZONE("Game::sRender");
+
+	// the render thread may still be drawing the last state, so this one goes into a slot of its own
+	// only copies go in, sLifespan fading a colour next frame can't change what is being drawn
+	RenderState& state = m_display->states.back();
+	state.shapes.clear();
+	state.rewindTicks = 0;
+
+	if (m_rewindStep > 0)
+	{
+		// stepping back while paused, the world comes from the rewind buffer instead
+		for (auto& [id, e] : m_rewindWorld)
+		{
+			Vec2 pos = e.position();
+			state.shapes.push_back({ pos.x, pos.y, e.degrees(), (float)e.radius, (float)e.thickness, e.points, e.fill, e.outline });
+		}
+		state.rewindTicks = (int)(m_rewind.tick(m_rewind.frames() - 1) - m_rewind.tick(m_rewind.frames() - 1 - m_rewindStep));
+	}
+	else
+	{
+		for (auto& e : m_entityManager.getEntities())
+		{
+			const sf::CircleShape& circle = e->cShape->circle;
+			state.shapes.push_back({ e->cTransform->pos.x, e->cTransform->pos.y, e->cTransform->angle, circle.getRadius(),
+				circle.getOutlineThickness(), (int)circle.getPointCount(), circle.getFillColor(), circle.getOutlineColor() });
+		}
+	}
+
+	m_particles.build(state.particles);
+	state.score = m_score;
+	state.reducedDetail = m_governor.active(MEASURE_DETAIL);
+	state.lodDebug = m_lodDebug;
+
+	m_display->states.publish();
+}
+
+// the render thread, draws every state sRender publishes until run() closes the buffer
+void Game::renderLoop()
+{
+	Trace::setThreadName("render");
+	m_display->window.setActive(true);
+
+	while (const RenderState* state = m_display->states.acquire())
+	{
+		sf::Clock clock;
+		draw(*state);
+		m_renderMicros = (int)clock.getElapsedTime().asMicroseconds();
+
+		// with a frame limit this is where the frame waits, so it gets its own zone
+		TRACE_ZONE("display");
+		m_display->window.display();
+	}
+
+	m_display->window.setActive(false);
+}
+
+void Game::draw(const RenderState& state)
+{
+	TRACE_ZONE("Game::draw");
+
+	sf::RenderWindow& window = m_display->window;
+	sf::VertexArray& batch = m_display->lodBatch;
+	sf::CircleShape& circle = m_display->circle;
+
+	// TODO: change the code below to draw ALL of the entities
+	//		 sample drawing of the player Entity that we have created
+	window.clear();
+	batch.clear();
+
+	// particles go first so they are drawn behind the entities
+	window.draw(state.particles);
+
+	int lodCount[3] = { 0, 0, 0 };
+	size_t vertices = 0;
+	int drawCalls = 0;
+
+	// reduced and point entities are batched, the batch is drawn before the next full entity so
+	// entities still overlap in the order they are stored. Runs of cheap entities are one call each
+	auto flush = [&]()
+	{
+		if (batch.getVertexCount() > 0)
+		{
+			window.draw(batch);
+			vertices += batch.getVertexCount();
+			drawCalls++;
+			batch.clear();
+		}
+	};
+
+	for (const RenderShape& s : state.shapes)
+	{
+		Vec2 pos(s.x, s.y);
+
+		LOD lod = levelOfDetail(s, state.reducedDetail);
+		lodCount[(int)lod]++;
+
+		if (lod == LOD::Full)
+		{
+			flush();
+
+			// one shape is set up for each entity in turn, the same as the entity's own CShape
+			circle.setRadius(s.radius);
+			circle.setPointCount(s.points);
+			circle.setOrigin(s.radius, s.radius);
+			circle.setFillColor(s.fill);
+			circle.setOutlineColor(s.outline);
+			circle.setOutlineThickness(s.thickness);
+			circle.setPosition(s.x, s.y);
+			circle.setRotation(s.angle);
+
+			//draw the entity's shape, a fan for the fill and a strip for the outline
+			window.draw(circle);
+			drawCalls++;
+			vertices += s.points + 2;
+			if (s.thickness > 0)
+			{
+				vertices += (s.points + 1) * 2;
+			}
+
+			if (state.lodDebug)
+			{
+				appendPoint(batch, pos, 3.0f, sf::Color::Green);
+			}
+		}
+		else if (lod == LOD::Reduced)
+		{
+			// one polygon in the fill colour covering the outline as well, with at most RV corners
+			size_t points = std::max((size_t)3, std::min((size_t)s.points, (size_t)m_lodConfig.RV));
+			appendPolygon(batch, pos, s.radius + s.thickness, points, s.angle, state.lodDebug ? sf::Color::Yellow : s.fill);
+		}
+		else
+		{
+			appendPoint(batch, pos, std::max(1.0f, (s.radius + s.thickness) * 0.75f), state.lodDebug ? sf::Color::Red : s.fill);
+		}
+	}
+
+	flush();
+
+	std::string text = "Score : " + std::to_string(state.score);
+	if (state.rewindTicks > 0)
+	{
+		text += "\nRewind : " + std::to_string(state.rewindTicks) + " ticks back";
+	}
+	if (state.lodDebug)
+	{
+		text += "\nLOD full/reduced/point : " + std::to_string(lodCount[0]) + " / " + std::to_string(lodCount[1]) + " / " + std::to_string(lodCount[2]);
+		text += "\nVertices : " + std::to_string(vertices) + " in " + std::to_string(drawCalls) + " draw calls";
+	}
+	m_display->text.setString(text);
+	window.draw(m_display->text);
+}
+
+void Game::sUserInput()
+{
+	TRACE_ZONE("Game::sUserInput");
+
+	// TODO: handle user input here
+	//		 note that you should only be setting player's input component variables here
+	//		 you should not implement the player's movement logic here
+	//		 the movement system will read the variables you set in this function
+
+	sf::Event event;
+	while (m_display->window.pollEvent(event))
+	{
+		// this event triggers when window is closed
+		if (event.type == sf::Event::Closed)
+		{
+			m_running = false;
+		}
+
+		// this event is triggered when a key is pressed
+		if (event.type == sf::Event::KeyPressed)
+		{
+			switch (event.key.code)
+			{
+			case sf::Keyboard::W:
+				// set player's input component "up" to true
+				m_player->cInput->up = true;
+				break;
+			case sf::Keyboard::A:
+				// set player's input component "left" to true
+				m_player->cInput->left = true;
+				break;
+			case sf::Keyboard::S:
+				// set player's input component "down" to true
+				m_player->cInput->down = true;
+				break;
+			case sf::Keyboard::D:
+				// set player's input component "right" to true
+				m_player->cInput->right = true;
+				break;
+			case sf::Keyboard::Escape:
+				// Pause the game
+				if (!m_paused)
+				{
+					setPaused(true);
+					std::cout << "Game is paused\n";
+					if (m_rewind.enabled())
+					{
+						std::cout << "Left / Right step through the last " << m_rewind.frames() << " ticks, Up / Down a second at a time ("
+							<< m_rewind.bytes() / 1024 << " KB)\n";
+					}
+				}
+				else
+				{
+					setPaused(false);
+					std::cout << "Game is unpaused\n";
+				}
+				break;
+			case sf::Keyboard::Left:
+				// while paused, step back one recorded tick
+				stepRewind(1);
+				break;
+			case sf::Keyboard::Right:
+				stepRewind(-1);
+				break;
+			case sf::Keyboard::Up:
+				// or a second's worth
+				stepRewind(m_windowConfig.FL);
+				break;
+			case sf::Keyboard::Down:
+				stepRewind(-m_windowConfig.FL);
+				break;
+			case sf::Keyboard::L:
+				// toggle the level of detail debug view
+				m_lodDebug = !m_lodDebug;
+				break;
+			case sf::Keyboard::T:
+				// start tracing, or stop and save the trace
+				Trace::setEnabled(!Trace::isEnabled());
+				if (Trace::isEnabled())
+				{
+					std::cout << "Tracing started\n";
+				}
+				else if (Trace::save("trace.json"))
+				{
+					std::cout << "Trace saved to trace.json\n";
+				}
+				break;
+			default: break;
+			}
+		}
+
+		// this event is triggered when a key is released
+		if (event.type == sf::Event::KeyReleased)
+		{
+			switch (event.key.code)
+			{
+			case sf::Keyboard::W:
+				// TODO: set player's input component "up" to false
+				m_player->cInput->up = false;
+				break;
+			case sf::Keyboard::A:
+				// set player's input component "left" to false
+				m_player->cInput->left = false;
+				break;
+			case sf::Keyboard::S:
+				// set player's input component "down" to false
+				m_player->cInput->down = false;
+				break;
+			case sf::Keyboard::D:
+				// set player's input component "right" to false
+				m_player->cInput->right = false;
+				break;
+			default: break;
+			}
+		}
+
+		if (event.type == sf::Event::MouseButtonPressed && !m_paused)
+		{
+			if (event.mouseButton.button == sf::Mouse::Left)
+			{
+				spawnBullet(m_player, Vec2(event.mouseButton.x, event.mouseButton.y));
+			}
+
+			if (event.mouseButton.button == sf::Mouse::Right)
+			{
+				spawnSpecialWeapon(m_player, Vec2(event.mouseButton.x, event.mouseButton.y));
+			}
+		}
+	}
 }
\ No newline at end of file
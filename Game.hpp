@@ -1,54 +1,148 @@
-#pragma once
-
-#include "Entity.hpp"
-#include "EntityManager.hpp"
-#include <SFML/Graphics.hpp>
-
-struct WindowConfig { int W, H, FL, FS; };
-struct FontConfig   { int S, R, G, B; };
-struct PlayerConfig { int SR, CR, FR, FG, FB, OR, OG, OB, OT, V; float S; };
-struct EnemyConfig	{ int SR, CR, OR, OG, OB, OT, VMIN, VMAX, L, SI; float SMIN, SMAX; };
-struct BulletConfig { int SR, CR, FR, FG, FB, OR, OG, OB, OT, V, L; float S; };
-
-class Game
-{
-	sf::RenderWindow	m_window;			// the window we will draw to
-	EntityManager		m_entityManager;	// vector of entities to maintain
-	sf::Font			m_font;				// the font we will use to draw
-	sf::Text			m_text;				// the score text to be drawn to the screen
-	WindowConfig		m_windowConfig;
-	FontConfig			m_fontConfig;
-	PlayerConfig		m_playerConfig;
-	EnemyConfig			m_enemyConfig;
-	BulletConfig		m_bulletConfig;
-	int					m_score = 0;
-	int					m_lastSpecialTime = 0;
-	int					m_currentFrame = 0;
-	int					m_lastEnemySpawnTime = 0;
-	bool				m_paused = false;	// whether we update game logic
-	bool				m_running = true;	// whether the game is running
-
-	std::shared_ptr<Entity> m_player;
-	
-	void init(const std::string& config);	// initialize the GameState with a config file path
-	void setPaused(bool paused);			// pause the game
-
-	void sMovement();						// System: Entity position / movement update
-	void sUserInput();						// System: User Input
-	void sLifespan();						// System: Lifespan
-	void sRender();							// System: Render / Drawing
-	void sEnemySpawner();					// System: Spawn Enemies
-	void sCollision();						// System: Collisions
-
-	void spawnPlayer();
-	void spawnEnemy();
-	void spawnSmallEnemies(std::shared_ptr<Entity> entity);
-	void spawnBullet(std::shared_ptr<Entity> entity, const Vec2& mousePos);
-	void spawnSpecialWeapon(std::shared_ptr<Entity> entity, const Vec2& target);
-
-public:
-
-	Game(const std::string& config);	// constructor, takes in game config
-
-	void run();
+#pragma once
+
+#include "Entity.hpp"
+#include "EntityManager.hpp"
+#include "ParticleSystem.hpp"
+#include "ForceField.hpp"
+#include "SpatialGrid.hpp"
+#include "WorkerPool.hpp"
+#include "Rewind.hpp"
+#include "Governor.hpp"
+#include "EventLog.hpp"
+#include "RenderState.hpp"
+#include "TripleBuffer.hpp"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <random>
+
+struct WindowConfig { int W, H, FL, FS; };
+struct FontConfig   { int S, R, G, B; };
+struct PlayerConfig { int SR, CR, FR, FG, FB, OR, OG, OB, OT, V; float S; };
+struct EnemyConfig	{ int SR, CR, OR, OG, OB, OT, VMIN, VMAX, L, SI; float SMIN, SMAX; };
+struct BulletConfig { int SR, CR, FR, FG, FB, OR, OG, OB, OT, V, L; float S; };
+struct LODConfig	{ int OR, OA, PR, PA, RV; };
+struct ParticleConfig { int N, S, L; };
+struct EventConfig	{ std::string F; int N; };
+struct FlockConfig	{ float R, S, A, C, P, M; };
+struct LocalityConfig { int P, N; };
+struct RewindConfig	{ int M, K; };
+
+// what a Game is run for, decides whether it has a window, a local player and extra threads
+enum class GameMode
+{
+	Play,		// a window and a local player at the keyboard
+	Simulate,	// headless, the bot is the local player, many run at once in the BatchRunner
+	Serve		// headless without a local player, players join through the Server
+};
+
+// level of detail an entity is drawn with, chosen every frame by the render thread
+enum class LOD { Full, Reduced, Point };
+
+// what happened during a simulated game, filled in by Game::simulate
+struct GameStats { int score = 0, deaths = 0, survivalTicks = 0, peakEntities = 0, ticks = 0; double tickMicros = 0.0; };
+
+// everything only a game with a window needs, a headless game never creates any of it
+struct Display
+{
+	sf::RenderWindow			window;		// the window we will draw to
+	sf::Font					font;		// the font we will use to draw
+	sf::Text					text;		// the score text to be drawn to the screen
+	TripleBuffer<RenderState>	states;		// published by sRender, drawn by the render thread
+	sf::VertexArray				lodBatch;	// reduced and point entities, drawn with as few calls as the order allows
+	sf::CircleShape				circle;		// the render thread's shape for full detail entities
+};
+
+class Game
+{
+	std::unique_ptr<Display> m_display;	// null in a headless game
+	EntityManager		m_entityManager;	// vector of entities to maintain
+	WindowConfig		m_windowConfig;
+	FontConfig			m_fontConfig;
+	PlayerConfig		m_playerConfig;
+	EnemyConfig			m_enemyConfig;
+	BulletConfig		m_bulletConfig;
+	LODConfig			m_lodConfig = { 12, 192, 3, 32, 6 };
+	bool				m_lodDebug = false;	// colour entities by their level of detail
+	ParticleConfig		m_particleConfig = { 200000, 24, 30 };
+	ParticleSystem		m_particles;		// cosmetic effects, kept out of the entity manager
+	ForceField			m_field;			// pull of the special weapon and other emitters
+	FlockConfig			m_flockConfig = { 0.0f, 1.0f, 0.1f, 0.5f, 0.02f, 0.3f };
+	SpatialGrid			m_flockGrid;		// steering enemies by position, for neighbour queries
+	std::vector<Vec2>	m_flockPos;			// positions and velocities of the steering enemies at the start of sFlock
+	std::vector<Vec2>	m_flockVel;
+	WorkerPool			m_workers;			// runs chunks of a system on the other cores
+	LocalityConfig		m_localityConfig = { 0, 1024 };
+	RewindConfig		m_rewindConfig = { 0, 60 };
+	RewindBuffer		m_rewind;			// the last few seconds, to step back through while paused
+	NetWorld			m_rewindWorld;		// the recorded world drawn instead of the live one
+	int					m_rewindStep = 0;	// frames behind the newest recorded one, 0 draws the live game
+	GovernorConfig		m_governorConfig = { 90, 10, 120, 31, 40 };
+	Governor			m_governor;			// trades detail and spawning for frame time under load
+	sf::Clock			m_frameClock;		// restarted at the start of every frame
+	sf::Time			m_workTime;			// time the last frame spent simulating
+	std::atomic<int>	m_renderMicros{ 0 };	// time the render thread spent drawing the last state
+	EventConfig			m_eventConfig = { "", 65536 };
+	EventLog			m_events;			// spawns, kills, deaths and specials for analytics
+	int					m_score = 0;
+	int					m_currentFrame = 0;
+	int					m_lastEnemySpawnTime = 0;
+	bool				m_paused = false;	// whether we update game logic
+	bool				m_running = true;	// whether the game is running
+	GameMode			m_mode = GameMode::Play;
+	bool				m_headless = false;	// no window, the game is only simulated or served
+	std::mt19937		m_rng;				// every random choice of this game comes from here
+	GameStats			m_stats;
+
+	std::shared_ptr<Entity> m_player;
+	
+	void init(const std::string& config);	// initialize the GameState with a config file path
+	void setPaused(bool paused);			// pause the game
+	void stepRewind(int frames);			// while paused, draw a recorded world further back (or forward)
+	int  random(int max);					// random number in [0, max)
+	void traceCounters();					// entity counts for the trace
+	void logEvent(EventType type, const std::shared_ptr<Entity>& entity, const std::shared_ptr<Entity>& other = nullptr, int value = 0);
+
+	void sMovement();						// System: Entity position / movement update
+	void sUserInput();						// System: User Input
+	void sLifespan();						// System: Lifespan
+	void sRender();							// System: Publish what to draw for the render thread
+	void sEnemySpawner();					// System: Spawn Enemies
+	void sCollision();						// System: Collisions
+	void sBot();							// System: Computer controlled player input
+	void sParticles();						// System: Cosmetic particle effects
+	void sField();							// System: Force field from emitters
+	void sFlock();							// System: Enemy steering
+	void sRewind();							// System: Record the world for stepping back
+
+	void renderLoop();						// body of the render thread
+	void draw(const RenderState& state);	// render thread: draws one published state
+	LOD  levelOfDetail(const RenderShape& shape, bool reducedDetail) const;
+
+	void spawnPlayer();
+	void spawnEnemy();
+	void spawnSmallEnemies(std::shared_ptr<Entity> entity);
+	void spawnExplosion(std::shared_ptr<Entity> entity);
+
+public:
+
+	Game(const std::string& config);	// constructor, takes in game config
+	Game(const std::string& config, GameMode mode, unsigned int seed);
+
+	void run();
+	void simulate(int ticks);			// run game logic only, with the bot playing
+	void step();						// one tick of game logic, however the game is run
+
+	// players of a served game, each driven by its client's input
+	std::shared_ptr<Entity> addPlayer();
+	void spawnBullet(std::shared_ptr<Entity> entity, const Vec2& mousePos);
+	void spawnSpecialWeapon(std::shared_ptr<Entity> entity, const Vec2& target);
+
+	int					currentFrame() const;
+	int					frameLimit() const;
+	int					score() const;
+	const EntityVec&	entities();
+
+	EnemyConfig&		enemyConfig();
+	BulletConfig&		bulletConfig();
+	const GameStats&	stats() const;
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Governor.hpp"
+#include <iostream>
+
+void Governor::init(const GovernorConfig& config, int frameLimit)
+{
+	m_config = config;
+	m_level = 0;
+	m_measures.clear();
+
+	// without a frame limit there is no budget to keep to, so the governor never steps up
+	if (frameLimit <= 0)
+	{
+		m_budget = 0.0f;
+		return;
+	}
+
+	m_budget = 1000000.0f / frameLimit * config.P / 100.0f;
+	for (int m = MEASURE_COSMETIC; m <= MEASURE_CAP; m <<= 1)
+	{
+		if (config.M & m)
+		{
+			m_measures.push_back(m);
+		}
+	}
+}
+
+void Governor::update(float workMicros, int frame)
+{
+	// headroom means comfortably under budget, so a level isn't dropped just to be raised again
+	m_over	= workMicros > m_budget ? m_over + 1 : 0;
+	m_under	= workMicros < m_budget * 0.6f ? m_under + 1 : 0;
+
+	if (m_over >= m_config.U && m_level < (int)m_measures.size())
+	{
+		std::cout << "Governor: frame " << frame << " took " << workMicros << " us of " << m_budget
+			<< " us, level " << m_level << " -> " << m_level + 1 << ", " << name(m_measures[m_level]) << " on\n";
+		m_level++;
+		m_over = 0;
+	}
+	else if (m_under >= m_config.D && m_level > 0)
+	{
+		m_level--;
+		std::cout << "Governor: frame " << frame << " took " << workMicros << " us of " << m_budget
+			<< " us, level " << m_level + 1 << " -> " << m_level << ", " << name(m_measures[m_level]) << " off\n";
+		m_under = 0;
+	}
+}
+
+bool Governor::active(GovernorMeasure measure) const
+{
+	for (int i = 0; i < m_level; i++)
+	{
+		if (m_measures[i] == measure)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int Governor::enemyCap() const
+{
+	return m_config.E;
+}
+
+int Governor::level() const
+{
+	return m_level;
+}
+
+std::string Governor::name(int measure)
+{
+	switch (measure)
+	{
+	case MEASURE_COSMETIC:	return "skip cosmetic work";
+	case MEASURE_DETAIL:	return "reduce render detail";
+	case MEASURE_FADES:		return "amortize lifespan fades";
+	case MEASURE_THROTTLE:	return "throttle spawning";
+	case MEASURE_CAP:		return "cap spawning";
+	default:				return "unknown";
+	}
+}
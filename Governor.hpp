@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// what the governor can do when a frame goes over budget, in the order they are applied
+enum GovernorMeasure
+{
+	MEASURE_COSMETIC	= 1,	// stop emitting particles
+	MEASURE_DETAIL		= 2,	// draw more entities at a reduced level of detail
+	MEASURE_FADES		= 4,	// update lifespan alpha on every other frame per entity
+	MEASURE_THROTTLE	= 8,	// spawn enemies half as often
+	MEASURE_CAP			= 16	// stop spawning above a number of enemies
+};
+
+struct GovernorConfig { int P, U, D, M, E; };
+
+// measures the work of every frame against a budget from the frame limit and turns measures on and off
+// one level per measure, stepping up after U frames over budget and down after D frames with headroom
+class Governor
+{
+	GovernorConfig		m_config = { 90, 10, 120, 31, 40 };
+	std::vector<int>	m_measures;				// the enabled measures, level n applies the first n
+	float				m_budget = 0.0f;		// microseconds of work per frame
+	int					m_level = 0;
+	int					m_over = 0;				// consecutive frames over budget
+	int					m_under = 0;			// consecutive frames with headroom
+
+	static std::string name(int measure);
+
+public:
+
+	void init(const GovernorConfig& config, int frameLimit);
+	void update(float workMicros, int frame);	// called once per frame with the time spent before display
+
+	bool active(GovernorMeasure measure) const;
+	int enemyCap() const;
+	int level() const;
+};
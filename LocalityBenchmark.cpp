@@ -0,0 +1,139 @@
+#include "LocalityBenchmark.hpp"
+#include "EntityManager.hpp"
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+LocalityBenchmark::LocalityBenchmark(size_t count, int ticks)
+	: m_count(count)
+	, m_ticks(ticks)
+{
+}
+
+void LocalityBenchmark::run(const std::string& mode, std::ostream& out) const
+{
+	Timing off = mode == "on" ? Timing() : run(false);
+	Timing on = mode == "off" ? Timing() : run(true);
+
+	auto print = [&](const char* name, const Timing& t)
+	{
+		out << name << t.pass << " us per tick neighbour pass + " << t.update << " us update (worst "
+			<< t.worstUpdate << " us), " << t.pairs << " pairs\n";
+	};
+
+	out << m_count << " entities, " << m_ticks << " ticks\n";
+	if (mode != "on")
+	{
+		print("spatial order off: ", off);
+	}
+	if (mode != "off")
+	{
+		print("spatial order on:  ", on);
+	}
+
+	// the sort and the moves are only worth it if the pass saves more than they cost
+	if (mode != "on" && mode != "off")
+	{
+		out << "net gain: " << (off.pass + off.update) - (on.pass + on.update) << " us per tick\n";
+	}
+}
+
+LocalityBenchmark::Timing LocalityBenchmark::run(bool sorted) const
+{
+	// about a dozen neighbours around each entity, like a busy screen
+	const float radius = 12.0f;
+	const float side = std::sqrt((float)m_count) * 24.0f;
+	const int warmup = 120;
+
+	EntityManager manager;
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> coord(0.0f, side), speed(-1.0f, 1.0f);
+	std::vector<std::shared_ptr<Entity>> slots(m_count);	// handles kept across sorts, churned by slot
+
+	if (sorted)
+	{
+		manager.setSpatialOrder(60, m_count / 10);
+	}
+
+	auto spawn = [&]()
+	{
+		auto e = manager.addEntity("enemy");
+		e->cTransform = std::make_shared<CTransform>(Vec2(coord(rng), coord(rng)), Vec2(speed(rng), speed(rng)));
+		e->cCollision = std::make_shared<CCollision>(radius);
+		return e;
+	};
+
+	for (auto& slot : slots)
+	{
+		slot = spawn();
+	}
+
+	SpatialGrid grid;
+	grid.resize(side, side, radius * 2);
+	std::vector<Vec2> positions;
+	Timing timing;
+
+	for (int tick = 0; tick < warmup + m_ticks; tick++)
+	{
+		auto updateStart = std::chrono::steady_clock::now();
+		manager.update();
+		double update = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - updateStart).count();
+
+		// one percent die and respawn somewhere else every tick
+		for (size_t i = 0; i < m_count / 100; i++)
+		{
+			auto& slot = slots[rng() % m_count];
+			slot->destroy();
+			slot = spawn();
+		}
+
+		for (auto& e : manager.getEntities())
+		{
+			Vec2& pos = e->cTransform->pos;
+			pos += e->cTransform->velocity;
+			pos.x = std::fmod(pos.x + side, side);
+			pos.y = std::fmod(pos.y + side, side);
+		}
+
+		// the timed pass: every entity against its neighbours, reading their transforms through the entities
+		auto start = std::chrono::steady_clock::now();
+
+		const auto& entities = manager.getEntities("enemy");
+		positions.resize(entities.size());
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			positions[i] = entities[i]->cTransform->pos;
+		}
+		grid.build(positions);
+
+		long long found = 0;
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			const Vec2& pos = entities[i]->cTransform->pos;
+			grid.forEachNear(pos, [&](int j)
+			{
+				const Vec2& other = entities[j]->cTransform->pos;
+				float dx = other.x - pos.x, dy = other.y - pos.y;
+				found += (dx * dx + dy * dy < radius * radius * 4) && j != (int)i;
+				return true;
+			});
+		}
+
+		if (tick >= warmup)
+		{
+			timing.pass += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+			timing.update += update;
+			timing.worstUpdate = std::max(timing.worstUpdate, update);
+			timing.pairs += found;
+		}
+	}
+
+	if (m_ticks > 0)
+	{
+		timing.pass /= m_ticks;
+		timing.update /= m_ticks;
+	}
+	return timing;
+}
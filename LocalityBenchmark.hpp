@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+// times a collision style neighbour pass over a large scene of wandering entities, with EntityManager's
+// spatial order off and on, along with the EntityManager::update that pays for the order. Entities die and respawn all the time like in a long game, so where they
+// were created says nothing about where they are
+class LocalityBenchmark
+{
+	// microseconds per timed tick
+	struct Timing
+	{
+		double		pass		= 0.0;	// the neighbour pass
+		double		update		= 0.0;	// EntityManager::update, which sorts and moves the transforms
+		double		worstUpdate	= 0.0;	// the slowest single update, a tick with the biggest step of a sort
+		long long	pairs		= 0;
+	};
+
+	size_t	m_count;
+	int		m_ticks;
+
+	Timing run(bool sorted) const;
+
+public:
+
+	LocalityBenchmark(size_t count, int ticks);
+
+	// mode is "on" or "off" to run only that one, for example under perf stat, anything else runs both
+	void run(const std::string& mode, std::ostream& out) const;
+};
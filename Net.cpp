@@ -0,0 +1,233 @@
+#include "Net.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+void PacketWriter::u8(uint8_t v)
+{
+	m_data.push_back(v);
+}
+
+void PacketWriter::u16(uint16_t v)
+{
+	m_data.push_back(v & 0xff);
+	m_data.push_back(v >> 8);
+}
+
+void PacketWriter::u32(uint32_t v)
+{
+	u16(v & 0xffff);
+	u16(v >> 16);
+}
+
+void PacketWriter::i8(int8_t v)
+{
+	u8((uint8_t)v);
+}
+
+void PacketWriter::i16(int16_t v)
+{
+	u16((uint16_t)v);
+}
+
+void PacketWriter::i32(int32_t v)
+{
+	u32((uint32_t)v);
+}
+
+void PacketWriter::patch16(size_t offset, uint16_t v)
+{
+	m_data[offset] = v & 0xff;
+	m_data[offset + 1] = v >> 8;
+}
+
+void PacketWriter::patch32(size_t offset, uint32_t v)
+{
+	patch16(offset, v & 0xffff);
+	patch16(offset + 2, v >> 16);
+}
+
+void PacketWriter::truncate(size_t size)
+{
+	m_data.resize(std::min(size, m_data.size()));
+}
+
+void PacketWriter::clear()
+{
+	m_data.clear();
+}
+
+size_t PacketWriter::size() const
+{
+	return m_data.size();
+}
+
+const std::vector<uint8_t>& PacketWriter::data() const
+{
+	return m_data;
+}
+
+PacketReader::PacketReader(const std::vector<uint8_t>& data)
+	: m_data(data.data())
+	, m_size(data.size())
+{
+}
+
+PacketReader::PacketReader(const uint8_t* data, size_t size)
+	: m_data(data)
+	, m_size(size)
+{
+}
+
+bool PacketReader::has(size_t bytes)
+{
+	if (m_pos + bytes > m_size)
+	{
+		m_ok = false;
+	}
+	return m_ok;
+}
+
+uint8_t PacketReader::u8()
+{
+	return has(1) ? m_data[m_pos++] : 0;
+}
+
+uint16_t PacketReader::u16()
+{
+	if (!has(2))
+	{
+		return 0;
+	}
+	uint16_t v = m_data[m_pos] | (m_data[m_pos + 1] << 8);
+	m_pos += 2;
+	return v;
+}
+
+uint32_t PacketReader::u32()
+{
+	uint32_t lo = u16();
+	uint32_t hi = u16();
+	return lo | (hi << 16);
+}
+
+int8_t PacketReader::i8()
+{
+	return (int8_t)u8();
+}
+
+int16_t PacketReader::i16()
+{
+	return (int16_t)u16();
+}
+
+int32_t PacketReader::i32()
+{
+	return (int32_t)u32();
+}
+
+bool PacketReader::ok() const
+{
+	return m_ok;
+}
+
+void writeInput(PacketWriter& out, const NetInput& input)
+{
+	out.u32(input.ack);
+	out.u8(input.up | input.left << 1 | input.right << 2 | input.down << 3 | input.shoot << 4 | input.special << 5);
+	out.i16(input.targetX);
+	out.i16(input.targetY);
+}
+
+NetInput readInput(PacketReader& in)
+{
+	NetInput input;
+	input.ack		= in.u32();
+	uint8_t keys	= in.u8();
+	input.up		= keys & 1;
+	input.left		= keys & 2;
+	input.right		= keys & 4;
+	input.down		= keys & 8;
+	input.shoot		= keys & 16;
+	input.special	= keys & 32;
+	input.targetX	= in.i16();
+	input.targetY	= in.i16();
+	return input;
+}
+
+static sockaddr_un address(const std::string& path)
+{
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path))
+	{
+		throw std::runtime_error("Socket path '" + path + "' is too long");
+	}
+	std::memcpy(addr.sun_path, path.c_str(), path.size());
+	return addr;
+}
+
+Socket::Socket(const std::string& path)
+	: m_path(path)
+{
+	sockaddr_un addr = address(path);
+
+	m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	if (m_fd < 0)
+	{
+		throw std::runtime_error("Could not create socket");
+	}
+
+	// a stale socket file from a previous run would make bind fail, anything else at the path is left alone
+	struct stat st;
+	if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+	{
+		unlink(path.c_str());
+	}
+	if (bind(m_fd, (sockaddr*)&addr, sizeof(addr)) < 0)
+	{
+		close(m_fd);
+		throw std::runtime_error("Could not bind socket '" + path + "'");
+	}
+
+	fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+}
+
+Socket::~Socket()
+{
+	close(m_fd);
+	unlink(m_path.c_str());
+}
+
+bool Socket::send(const std::string& to, const std::vector<uint8_t>& data)
+{
+	sockaddr_un addr = address(to);
+	return sendto(m_fd, data.data(), data.size(), 0, (sockaddr*)&addr, sizeof(addr)) == (ssize_t)data.size();
+}
+
+bool Socket::receive(std::vector<uint8_t>& data, std::string& from)
+{
+	sockaddr_un addr;
+	socklen_t addrLen = sizeof(addr);
+	data.resize(65536);
+
+	ssize_t n = recvfrom(m_fd, data.data(), data.size(), 0, (sockaddr*)&addr, &addrLen);
+	if (n < 0)
+	{
+		data.clear();
+		return false;
+	}
+
+	data.resize(n);
+	// the path isn't terminated when it fills sun_path, so it is never read past what the kernel wrote
+	size_t pathLen = addrLen > offsetof(sockaddr_un, sun_path) ? strnlen(addr.sun_path, addrLen - offsetof(sockaddr_un, sun_path)) : 0;
+	from = std::string(addr.sun_path, pathLen);
+	return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum PacketType : uint8_t
+{
+	PACKET_HELLO	= 1,	// client -> server, join the game
+	PACKET_INPUT	= 2,	// client -> server, input and the newest snapshot received
+	PACKET_BYE		= 3,	// client -> server, leave the game
+	PACKET_SNAPSHOT	= 4		// server -> client, world state as a delta from an acknowledged snapshot
+};
+
+// the input a client sends every frame, shoot and special are one-shot like a mouse click
+struct NetInput
+{
+	uint32_t	ack		= 0;		// sequence of the newest snapshot the client has decoded
+	bool		up		= false;
+	bool		left	= false;
+	bool		right	= false;
+	bool		down	= false;
+	bool		shoot	= false;
+	bool		special	= false;
+	int16_t		targetX	= 0;
+	int16_t		targetY	= 0;
+};
+
+// writes little endian values to the end of a packet
+class PacketWriter
+{
+	std::vector<uint8_t> m_data;
+
+public:
+
+	void u8(uint8_t v);
+	void u16(uint16_t v);
+	void u32(uint32_t v);
+	void i8(int8_t v);
+	void i16(int16_t v);
+	void i32(int32_t v);
+	void patch16(size_t offset, uint16_t v);	// overwrite a u16 written earlier
+	void patch32(size_t offset, uint32_t v);
+	void truncate(size_t size);					// drop what was written after the first size bytes
+	void clear();								// empty, keeping the memory for the next packet
+
+	size_t size() const;
+	const std::vector<uint8_t>& data() const;
+};
+
+// reads little endian values from a packet, reading past the end yields zeros and clears ok()
+class PacketReader
+{
+	const uint8_t*	m_data;
+	size_t			m_size;
+	size_t			m_pos	= 0;
+	bool			m_ok	= true;
+
+	bool has(size_t bytes);
+
+public:
+
+	PacketReader(const std::vector<uint8_t>& data);
+	PacketReader(const uint8_t* data, size_t size);
+
+	uint8_t  u8();
+	uint16_t u16();
+	uint32_t u32();
+	int8_t   i8();
+	int16_t  i16();
+	int32_t  i32();
+
+	bool ok() const;
+};
+
+void writeInput(PacketWriter& out, const NetInput& input);
+NetInput readInput(PacketReader& in);
+
+// a non-blocking unix datagram socket bound to a path, every peer is addressed by its path
+class Socket
+{
+	int			m_fd = -1;
+	std::string	m_path;
+
+public:
+
+	Socket(const std::string& path);
+	~Socket();
+
+	Socket(const Socket&) = delete;
+	Socket& operator = (const Socket&) = delete;
+
+	bool send(const std::string& to, const std::vector<uint8_t>& data);
+	bool receive(std::vector<uint8_t>& data, std::string& from);	// false when nothing is waiting
+};
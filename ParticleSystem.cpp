@@ -0,0 +1,140 @@
+#include "ParticleSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+ParticleSystem::ParticleSystem()
+{
+}
+
+void ParticleSystem::setCapacity(size_t capacity)
+{
+	m_x.assign(capacity, 0.0f);
+	m_y.assign(capacity, 0.0f);
+	m_vx.assign(capacity, 0.0f);
+	m_vy.assign(capacity, 0.0f);
+	m_life.assign(capacity, 0.0f);
+	m_fade.assign(capacity, 0.0f);
+	m_size.assign(capacity, 0.0f);
+	m_color.assign(capacity, sf::Color());
+	m_next = 0;
+	m_used = 0;
+}
+
+size_t ParticleSystem::capacity() const
+{
+	return m_life.size();
+}
+
+void ParticleSystem::emit(const Vec2& pos, const Vec2& velocity, float size, int lifespan, const sf::Color& color)
+{
+	if (capacity() == 0 || lifespan <= 0)
+	{
+		return;
+	}
+
+	size_t i = m_next;
+	m_x[i]		= pos.x;
+	m_y[i]		= pos.y;
+	m_vx[i]		= velocity.x;
+	m_vy[i]		= velocity.y;
+	m_life[i]	= (float)lifespan;
+	m_fade[i]	= 1.0f / lifespan;
+	m_size[i]	= size;
+	m_color[i]	= color;
+
+	m_next = (m_next + 1) % capacity();
+	m_used = std::max(m_used, i + 1);
+}
+
+void ParticleSystem::burst(const Vec2& pos, int count, float speed, float size, int lifespan, const sf::Color& color)
+{
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> magnitude(0.2f * speed, speed);
+
+	for (int i = 0; i < count; i++)
+	{
+		float a = angle(m_rng), m = magnitude(m_rng);
+		emit(pos, Vec2(m * cos(a), m * sin(a)), size, lifespan, color);
+	}
+}
+
+void ParticleSystem::update()
+{
+	const float drag = 0.95f;
+	const size_t n = m_used;
+
+	float* x	= m_x.data();
+	float* y	= m_y.data();
+	float* vx	= m_vx.data();
+	float* vy	= m_vy.data();
+	float* life	= m_life.data();
+	size_t live	= 0;
+
+	// dead particles are updated too, skipping them would cost a branch per particle
+	for (size_t i = 0; i < n; i++)
+	{
+		x[i]	+= vx[i];
+		y[i]	+= vy[i];
+		vx[i]	*= drag;
+		vy[i]	*= drag;
+		life[i]	-= 1.0f;
+		live	+= life[i] > 0.0f;
+	}
+
+	if (n > 0 && live * 2 <= n)
+	{
+		compact();
+	}
+}
+
+void ParticleSystem::compact()
+{
+	// keeps the order of the live particles, the next ones are written right after them
+	size_t used = 0;
+	for (size_t i = 0; i < m_used; i++)
+	{
+		if (m_life[i] <= 0.0f)
+		{
+			continue;
+		}
+
+		m_x[used]		= m_x[i];
+		m_y[used]		= m_y[i];
+		m_vx[used]		= m_vx[i];
+		m_vy[used]		= m_vy[i];
+		m_life[used]	= m_life[i];
+		m_fade[used]	= m_fade[i];
+		m_size[used]	= m_size[i];
+		m_color[used]	= m_color[i];
+		used++;
+	}
+
+	m_used = used;
+	m_next = used;
+}
+
+void ParticleSystem::build(sf::VertexArray& vertices) const
+{
+	vertices.setPrimitiveType(sf::Quads);
+	vertices.resize(m_used * 4);
+	size_t v = 0;
+
+	for (size_t i = 0; i < m_used; i++)
+	{
+		if (m_life[i] <= 0.0f)
+		{
+			continue;
+		}
+
+		sf::Color c = m_color[i];
+		c.a = (sf::Uint8)(c.a * m_life[i] * m_fade[i]);
+
+		float s = m_size[i];
+		vertices[v++] = sf::Vertex(sf::Vector2f(m_x[i] - s, m_y[i] - s), c);
+		vertices[v++] = sf::Vertex(sf::Vector2f(m_x[i] + s, m_y[i] - s), c);
+		vertices[v++] = sf::Vertex(sf::Vector2f(m_x[i] + s, m_y[i] + s), c);
+		vertices[v++] = sf::Vertex(sf::Vector2f(m_x[i] - s, m_y[i] + s), c);
+	}
+
+	vertices.resize(v);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Vec2.hpp"
+#include <SFML/Graphics.hpp>
+#include <random>
+#include <vector>
+
+// cosmetic particles (sparks, trails, glows) that never touch gameplay and never go through the EntityManager
+// particles live in a preallocated ring buffer, when it is full a new particle replaces the oldest one
+// once most of the used slots hold dead particles the live ones are moved to the front, so a burst
+// of particles doesn't leave every later frame going over all the slots it once filled
+class ParticleSystem
+{
+	// one array per field so update() is a straight pass over floats the compiler can vectorize
+	std::vector<float>		m_x, m_y;
+	std::vector<float>		m_vx, m_vy;
+	std::vector<float>		m_life;			// frames left to live, dead at zero or below
+	std::vector<float>		m_fade;			// 1 / total lifespan, alpha is life * fade
+	std::vector<float>		m_size;			// half the side of the particle's square
+	std::vector<sf::Color>	m_color;
+	size_t					m_next = 0;		// ring buffer slot the next particle is written to
+	size_t					m_used = 0;		// slots that held a particle since the last compact()
+	std::minstd_rand		m_rng;
+
+	void compact();							// move the live particles to the front of the buffer
+
+public:
+
+	ParticleSystem();
+
+	void setCapacity(size_t capacity);
+	size_t capacity() const;
+
+	void emit(const Vec2& pos, const Vec2& velocity, float size, int lifespan, const sf::Color& color);
+	void burst(const Vec2& pos, int count, float speed, float size, int lifespan, const sf::Color& color);	// random directions and speeds up to speed
+
+	void update();							// move and age every particle by one frame
+	void build(sf::VertexArray& vertices) const;	// every live particle as a quad, to be drawn with a single call
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// everything needed to draw one entity, copied out of its components by the simulation
+struct RenderShape
+{
+	float		x, y;
+	float		angle;
+	float		radius;
+	float		thickness;
+	int			points;
+	sf::Color	fill;
+	sf::Color	outline;
+};
+
+// what the render thread draws for one tick, published by Game::sRender
+// nothing in here points back into the simulation, so the next tick can run while it is drawn
+struct RenderState
+{
+	std::vector<RenderShape>	shapes;
+	sf::VertexArray				particles;
+	int							score			= 0;
+	bool						reducedDetail	= false;	// the governor asks for cheaper shapes
+	bool						lodDebug		= false;
+	int							rewindTicks		= 0;		// how far behind the live game the drawn world is
+};
@@ -0,0 +1,177 @@
+#include "Rewind.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstring>
+
+void RewindBuffer::init(size_t bytes, int keyInterval)
+{
+	m_data.assign(bytes, 0);
+	m_frames.clear();
+	m_head = 0;
+	m_keyInterval = std::max(1, keyInterval);
+	m_sinceKey = 0;
+	m_last.clear();
+}
+
+bool RewindBuffer::enabled() const
+{
+	return !m_data.empty();
+}
+
+void RewindBuffer::record(uint32_t tick, const EntityVec& entities)
+{
+	if (!enabled())
+	{
+		return;
+	}
+
+	TRACE_ZONE("RewindBuffer::record");
+
+	bool key = m_sinceKey == 0;
+	m_sinceKey = key ? m_keyInterval - 1 : m_sinceKey - 1;
+
+	// a keyframe is every entity as a delta from nothing
+	if (key)
+	{
+		m_last.clear();
+	}
+
+	// the changed entities, then the ids of the ones destroyed this tick
+	// entities destroyed this tick are still in the vectors, they are gone from the next update()
+	m_out.clear();
+	uint32_t changed = 0, removed = 0;
+	m_out.u32(0);
+
+	for (auto& e : entities)
+	{
+		if (!e->isActive())
+		{
+			continue;
+		}
+
+		uint32_t id = (uint32_t)e->id();
+		NetEntity n = quantize(*e);
+		NetEntity& last = m_last[id];
+		if (writeEntityDelta(m_out, id, n, last))
+		{
+			last = n;
+			changed++;
+		}
+	}
+	m_out.patch32(0, changed);
+
+	size_t removedAt = m_out.size();
+	m_out.u32(0);
+	for (auto& e : entities)
+	{
+		if (!e->isActive() && m_last.erase((uint32_t)e->id()) > 0)
+		{
+			m_out.u32((uint32_t)e->id());
+			removed++;
+		}
+	}
+	m_out.patch32(removedAt, removed);
+
+	store(tick, key);
+}
+
+void RewindBuffer::store(uint32_t tick, bool key)
+{
+	size_t size = m_out.size();
+
+	// a frame bigger than the whole ring can't be kept, and the frames after it can't do without it
+	if (size > m_data.size())
+	{
+		m_frames.clear();
+		m_head = 0;
+		m_sinceKey = 0;
+		return;
+	}
+
+	// frames are never split, one that doesn't fit before the end of the ring goes to its start
+	// the frames left between the head and the end are the oldest ones and go first
+	if (m_head + size > m_data.size())
+	{
+		while (!m_frames.empty() && m_frames.front().offset >= m_head)
+		{
+			m_frames.pop_front();
+		}
+		m_head = 0;
+	}
+
+	// then the oldest frames the new one overwrites
+	while (!m_frames.empty() && m_frames.front().offset >= m_head && m_frames.front().offset < m_head + size)
+	{
+		m_frames.pop_front();
+	}
+
+	std::memcpy(&m_data[m_head], m_out.data().data(), size);
+	m_frames.push_back({ tick, m_head, size, key });
+	m_head += size;
+
+	// deltas whose keyframe was dropped can't be decoded any more
+	while (!m_frames.empty() && !m_frames.front().key)
+	{
+		m_frames.pop_front();
+	}
+}
+
+size_t RewindBuffer::frames() const
+{
+	return m_frames.size();
+}
+
+uint32_t RewindBuffer::tick(size_t frame) const
+{
+	return m_frames[frame].tick;
+}
+
+size_t RewindBuffer::bytes() const
+{
+	size_t total = 0;
+	for (auto& f : m_frames)
+	{
+		total += f.size;
+	}
+	return total;
+}
+
+bool RewindBuffer::seek(uint32_t tick, NetWorld& world) const
+{
+	// frames are in tick order, the one wanted is the last at or before tick
+	auto it = std::upper_bound(m_frames.begin(), m_frames.end(), tick,
+		[](uint32_t t, const Frame& f) { return t < f.tick; });
+	if (it == m_frames.begin())
+	{
+		return false;
+	}
+
+	size_t last = (it - m_frames.begin()) - 1;
+	size_t first = last;
+	while (!m_frames[first].key)
+	{
+		first--;
+	}
+
+	world.clear();
+	for (size_t i = first; i <= last; i++)
+	{
+		const Frame& f = m_frames[i];
+		PacketReader in(&m_data[f.offset], f.size);
+
+		for (uint32_t n = 0, changed = in.u32(); n < changed; n++)
+		{
+			readEntityDelta(in, world);
+		}
+		for (uint32_t n = 0, removed = in.u32(); n < removed; n++)
+		{
+			world.erase(in.u32());
+		}
+
+		if (!in.ok())
+		{
+			return false;
+		}
+	}
+	return true;
+}
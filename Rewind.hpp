@@ -0,0 +1,46 @@
+#pragma once
+
+#include "EntityManager.hpp"
+#include "Snapshot.hpp"
+#include <deque>
+
+// the last few seconds of the world, for stepping back through them while the game is paused
+// every tick is stored as a frame in a fixed size ring of bytes: a keyframe with every entity every
+// K ticks, and in between only the entities that changed since the tick before and the ids of the
+// ones that died, in the snapshot encoding. When the ring is full the oldest frames are dropped,
+// so the memory used never grows past what init() was given
+class RewindBuffer
+{
+	struct Frame
+	{
+		uint32_t	tick;
+		size_t		offset;			// into m_data
+		size_t		size;
+		bool		key;
+	};
+
+	std::vector<uint8_t>	m_data;				// the ring, empty when rewind is off
+	std::deque<Frame>		m_frames;			// oldest first, always starting with a keyframe
+	size_t					m_head			= 0;	// where the next frame goes
+	int						m_keyInterval	= 60;
+	int						m_sinceKey		= 0;	// frames until the next keyframe, 0 makes the next one a keyframe
+	NetWorld				m_last;				// the world as of the last frame, deltas are against it
+	PacketWriter			m_out;				// the frame being recorded, reused
+
+	void store(uint32_t tick, bool key);
+
+public:
+
+	void init(size_t bytes, int keyInterval);
+	bool enabled() const;
+
+	// records a tick, the cost is a quantize and a compare per entity and bytes only for what changed
+	void record(uint32_t tick, const EntityVec& entities);
+
+	size_t frames() const;
+	uint32_t tick(size_t frame) const;			// frame 0 is the oldest kept
+	size_t bytes() const;						// used by the frames kept
+
+	// the world at the newest kept tick at or before tick, decoded from the keyframe before it
+	bool seek(uint32_t tick, NetWorld& world) const;
+};
@@ -0,0 +1,243 @@
+#include "Server.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+Server::Server(const std::string& config, const std::string& path, size_t budget)
+	: m_game(config, GameMode::Serve, std::random_device{}())
+	, m_socket(path)
+	, m_budget(budget)
+{
+	// a frame limit of 0 runs the server unpaced, reports and timeouts then take 60 ticks for a second
+	m_tickRate = m_game.frameLimit() > 0 ? m_game.frameLimit() : 60;
+}
+
+void Server::run(int ticks)
+{
+	sf::Clock clock;
+	sf::Time frame = m_game.frameLimit() > 0 ? sf::seconds(1.0f / m_game.frameLimit()) : sf::Time::Zero;
+
+	for (int tick = 0; ticks == 0 || tick < ticks; tick++)
+	{
+		clock.restart();
+
+		auto start = std::chrono::steady_clock::now();
+		receive();
+		m_game.step();
+		sendSnapshots();
+		m_tickMicros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		if ((tick + 1) % m_tickRate == 0)
+		{
+			report(m_tickRate);
+		}
+
+		// the server keeps the same tick rate as the clients' frame limit
+		sf::sleep(frame - clock.getElapsedTime());
+	}
+}
+
+void Server::receive()
+{
+	std::vector<uint8_t> data;
+	std::string from;
+
+	while (m_socket.receive(data, from))
+	{
+		PacketReader in(data);
+		uint8_t type = in.u8();
+
+		auto it = m_clients.find(from);
+		if (it == m_clients.end())
+		{
+			if (type != PACKET_HELLO && type != PACKET_INPUT)
+			{
+				continue;
+			}
+
+			// every new client gets its own player in the middle of the screen
+			it = m_clients.emplace(from, ServerClient()).first;
+			it->second.player = m_game.addPlayer();
+			std::cout << "Client '" << from << "' joined\n";
+		}
+
+		ServerClient& client = it->second;
+		client.lastHeard = m_game.currentFrame();
+
+		if (type == PACKET_BYE)
+		{
+			std::cout << "Client '" << from << "' left\n";
+			client.player->destroy();
+			m_clients.erase(it);
+		}
+		else if (type == PACKET_INPUT)
+		{
+			NetInput input = readInput(in);
+			if (!in.ok())
+			{
+				continue;
+			}
+
+			// acks can arrive out of order, only ever move the baseline forward
+			client.acked = std::max(client.acked, std::min(input.ack, client.sequence));
+
+			client.player->cInput->up		= input.up;
+			client.player->cInput->left		= input.left;
+			client.player->cInput->right	= input.right;
+			client.player->cInput->down		= input.down;
+
+			Vec2 target(input.targetX, input.targetY);
+			if (input.shoot && target != client.player->cTransform->pos)
+			{
+				m_game.spawnBullet(client.player, target);
+			}
+			if (input.special && target != client.player->cTransform->pos)
+			{
+				m_game.spawnSpecialWeapon(client.player, target);
+			}
+		}
+	}
+
+	// drop clients we haven't heard from for five seconds
+	for (auto it = m_clients.begin(); it != m_clients.end();)
+	{
+		if (m_game.currentFrame() - it->second.lastHeard > m_tickRate * 5)
+		{
+			std::cout << "Client '" << it->first << "' timed out\n";
+			it->second.player->destroy();
+			it = m_clients.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void Server::sendSnapshots()
+{
+	TRACE_ZONE("Server::sendSnapshots");
+
+	// the world is quantized once per tick and shared by every client's delta
+	NetWorld world;
+	for (auto& e : m_game.entities())
+	{
+		if (e->isActive())
+		{
+			world[(uint32_t)e->id()] = quantize(*e);
+		}
+	}
+
+	for (auto& [path, client] : m_clients)
+	{
+		sendSnapshot(path, client, world);
+	}
+}
+
+void Server::sendSnapshot(const std::string& path, ServerClient& client, const NetWorld& world)
+{
+	static const NetEntity none;
+
+	// deltas are against the newest snapshot the client acknowledged, or against nothing
+	const NetWorld* baseline = client.history.find(client.acked);
+	NetWorld sent = baseline ? *baseline : NetWorld();
+	uint32_t sequence = ++client.sequence;
+
+	PacketWriter out;
+	out.u8(PACKET_SNAPSHOT);
+	out.u32(sequence);
+	out.u32(baseline ? client.acked : 0);
+	out.u32((uint32_t)client.player->id());
+	out.i32(m_game.score());
+
+	// removals are cheap and always sent, a client must never keep drawing a dead entity
+	size_t removedAt = out.size();
+	uint16_t removed = 0;
+	out.u16(0);
+	for (auto it = sent.begin(); it != sent.end();)
+	{
+		if (world.count(it->first) == 0)
+		{
+			out.u32(it->first);
+			it = sent.erase(it);
+			removed++;
+		}
+		else
+		{
+			++it;
+		}
+	}
+	out.patch16(removedAt, removed);
+
+	for (auto it = client.priority.begin(); it != client.priority.end();)
+	{
+		it = world.count(it->first) == 0 ? client.priority.erase(it) : std::next(it);
+	}
+
+	// every entity that differs from the baseline gains priority each tick until it is sent,
+	// players and entities close to the client's own player gain it faster
+	std::vector<std::pair<float, uint32_t>> changed;
+	const Vec2& center = client.player->cTransform->pos;
+
+	for (auto& [id, e] : world)
+	{
+		auto base = sent.find(id);
+		if (base != sent.end() && base->second == e)
+		{
+			continue;
+		}
+
+		float distance = center.dist(e.position()).length();
+		float relevance = 1.0f + 4.0f * std::max(0.0f, 1.0f - distance / 1000.0f);
+		if (tagName(e.tag) == "player")
+		{
+			relevance += 8.0f;
+		}
+
+		float& priority = client.priority[id];
+		priority += relevance;
+		changed.push_back({ priority, id });
+	}
+
+	std::sort(changed.begin(), changed.end(), std::greater<std::pair<float, uint32_t>>());
+
+	// entities that don't fit the budget keep their old state on the client and try again next tick
+	size_t changedAt = out.size();
+	uint16_t written = 0;
+	out.u16(0);
+	for (auto& [priority, id] : changed)
+	{
+		// a delta is only known to fit once it is written, one that doesn't is taken back out
+		size_t entityAt = out.size();
+		auto base = sent.find(id);
+		const NetEntity& e = world.at(id);
+		writeEntityDelta(out, id, e, base != sent.end() ? base->second : none);
+
+		if (out.size() > m_budget)
+		{
+			out.truncate(entityAt);
+			break;
+		}
+
+		sent[id] = e;
+		client.priority[id] = 0.0f;
+		written++;
+	}
+	out.patch16(changedAt, written);
+
+	client.history.store(sequence, sent);
+	client.bytesSent += out.size();
+	m_socket.send(path, out.data());
+}
+
+void Server::report(int ticks)
+{
+	std::cout << "Server tick " << m_tickMicros / ticks << " us, " << m_game.entities().size() << " entities\n";
+	for (auto& [path, client] : m_clients)
+	{
+		std::cout << "  client '" << path << "' " << client.bytesSent * m_tickRate / ticks << " bytes/s\n";
+		client.bytesSent = 0;
+	}
+	m_tickMicros = 0.0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Game.hpp"
+#include "Net.hpp"
+#include "Snapshot.hpp"
+#include <map>
+
+// a client connected to the Server, with everything needed to send it deltas
+struct ServerClient
+{
+	std::shared_ptr<Entity>					player;
+	SnapshotHistory							history;		// worlds this client was sent, by sequence
+	std::unordered_map<uint32_t, float>		priority;		// grows every tick an entity's change isn't sent
+	uint32_t								sequence	= 0;	// last snapshot sent
+	uint32_t								acked		= 0;	// newest snapshot the client has decoded
+	int										lastHeard	= 0;	// tick of the last packet from the client
+	size_t									bytesSent	= 0;	// since the last report
+};
+
+// runs the authoritative game and sends every client a delta compressed snapshot each tick
+class Server
+{
+	Game									m_game;
+	Socket									m_socket;
+	std::map<std::string, ServerClient>		m_clients;		// by the client's socket path
+	size_t									m_budget;		// snapshot size in bytes a client is sent at most per tick
+	double									m_tickMicros = 0.0;	// since the last report
+	int										m_tickRate	= 60;	// ticks per second
+
+	void receive();
+	void sendSnapshots();
+	void sendSnapshot(const std::string& path, ServerClient& client, const NetWorld& world);
+	void report(int ticks);
+
+public:
+
+	Server(const std::string& config, const std::string& path, size_t budget = 1200);
+
+	void run(int ticks);	// run for a number of ticks, forever if ticks is 0
+};
@@ -0,0 +1,132 @@
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <cmath>
+
+// which fields of an entity a delta carries
+enum DeltaField : uint8_t
+{
+	FIELD_POS		= 1,	// absolute position
+	FIELD_POS_SMALL	= 2,	// position as a one byte offset per axis from the baseline
+	FIELD_VEL		= 4,
+	FIELD_ANGLE		= 8,
+	FIELD_SHAPE		= 16,	// tag, radius, points and outline thickness
+	FIELD_COLOR		= 32,	// fill and outline rgb
+	FIELD_ALPHA		= 64	// fill and outline alpha, changes every tick while a lifespan fades
+};
+
+static int16_t quantize16(float value, float scale)
+{
+	return (int16_t)std::max(-32767.0f, std::min(32767.0f, std::round(value * scale)));
+}
+
+Vec2 NetEntity::position() const
+{
+	return Vec2(x / 8.0f, y / 8.0f);
+}
+
+Vec2 NetEntity::velocity() const
+{
+	return Vec2(vx / 64.0f, vy / 64.0f);
+}
+
+float NetEntity::degrees() const
+{
+	return angle * 360.0f / 256.0f;
+}
+
+bool NetEntity::operator == (const NetEntity& rhs) const
+{
+	return tag == rhs.tag && x == rhs.x && y == rhs.y && vx == rhs.vx && vy == rhs.vy && angle == rhs.angle
+		&& radius == rhs.radius && points == rhs.points && thickness == rhs.thickness
+		&& fill == rhs.fill && outline == rhs.outline;
+}
+
+NetEntity quantize(const Entity& e)
+{
+	NetEntity n;
+	n.tag		= tagId(e.tag());
+	n.x			= quantize16(e.cTransform->pos.x, 8.0f);
+	n.y			= quantize16(e.cTransform->pos.y, 8.0f);
+	n.vx		= quantize16(e.cTransform->velocity.x, 64.0f);
+	n.vy		= quantize16(e.cTransform->velocity.y, 64.0f);
+	n.angle		= (uint8_t)((int)std::round(e.cTransform->angle * 256.0f / 360.0f) & 0xff);
+	n.radius	= (uint8_t)std::min(255.0f, e.cShape->circle.getRadius());
+	n.points	= (uint8_t)std::min((size_t)255, e.cShape->circle.getPointCount());
+	n.thickness	= (uint8_t)std::min(255.0f, e.cShape->circle.getOutlineThickness());
+	n.fill		= e.cShape->circle.getFillColor();
+	n.outline	= e.cShape->circle.getOutlineColor();
+	return n;
+}
+
+bool writeEntityDelta(PacketWriter& out, uint32_t id, const NetEntity& e, const NetEntity& base)
+{
+	uint8_t mask = 0;
+	int dx = e.x - base.x, dy = e.y - base.y;
+
+	if (dx != 0 || dy != 0)
+	{
+		mask |= (std::abs(dx) <= 127 && std::abs(dy) <= 127) ? FIELD_POS_SMALL : FIELD_POS;
+	}
+	if (e.vx != base.vx || e.vy != base.vy)																{ mask |= FIELD_VEL; }
+	if (e.angle != base.angle)																			{ mask |= FIELD_ANGLE; }
+	if (e.tag != base.tag || e.radius != base.radius || e.points != base.points || e.thickness != base.thickness)	{ mask |= FIELD_SHAPE; }
+	if (e.fill.r != base.fill.r || e.fill.g != base.fill.g || e.fill.b != base.fill.b ||
+		e.outline.r != base.outline.r || e.outline.g != base.outline.g || e.outline.b != base.outline.b)	{ mask |= FIELD_COLOR; }
+	if (e.fill.a != base.fill.a || e.outline.a != base.outline.a)										{ mask |= FIELD_ALPHA; }
+
+	if (mask == 0)
+	{
+		return false;
+	}
+
+	out.u32(id);
+	out.u8(mask);
+	if (mask & FIELD_POS)		{ out.i16(e.x); out.i16(e.y); }
+	if (mask & FIELD_POS_SMALL)	{ out.i8((int8_t)dx); out.i8((int8_t)dy); }
+	if (mask & FIELD_VEL)		{ out.i16(e.vx); out.i16(e.vy); }
+	if (mask & FIELD_ANGLE)		{ out.u8(e.angle); }
+	if (mask & FIELD_SHAPE)		{ out.u8(e.tag); out.u8(e.radius); out.u8(e.points); out.u8(e.thickness); }
+	if (mask & FIELD_COLOR)
+	{
+		out.u8(e.fill.r); out.u8(e.fill.g); out.u8(e.fill.b);
+		out.u8(e.outline.r); out.u8(e.outline.g); out.u8(e.outline.b);
+	}
+	if (mask & FIELD_ALPHA)		{ out.u8(e.fill.a); out.u8(e.outline.a); }
+	return true;
+}
+
+void readEntityDelta(PacketReader& in, NetWorld& world)
+{
+	uint32_t id = in.u32();
+	uint8_t mask = in.u8();
+
+	// an entity missing from the baseline is a new one, its delta is against a default entity
+	NetEntity& e = world[id];
+
+	if (mask & FIELD_POS)		{ e.x = in.i16(); e.y = in.i16(); }
+	if (mask & FIELD_POS_SMALL)	{ e.x += in.i8(); e.y += in.i8(); }
+	if (mask & FIELD_VEL)		{ e.vx = in.i16(); e.vy = in.i16(); }
+	if (mask & FIELD_ANGLE)		{ e.angle = in.u8(); }
+	if (mask & FIELD_SHAPE)		{ e.tag = in.u8(); e.radius = in.u8(); e.points = in.u8(); e.thickness = in.u8(); }
+	if (mask & FIELD_COLOR)
+	{
+		e.fill.r = in.u8(); e.fill.g = in.u8(); e.fill.b = in.u8();
+		e.outline.r = in.u8(); e.outline.g = in.u8(); e.outline.b = in.u8();
+	}
+	if (mask & FIELD_ALPHA)		{ e.fill.a = in.u8(); e.outline.a = in.u8(); }
+}
+
+void SnapshotHistory::store(uint32_t sequence, const NetWorld& world)
+{
+	m_worlds[sequence % Size] = world;
+	m_sequences[sequence % Size] = sequence;
+}
+
+const NetWorld* SnapshotHistory::find(uint32_t sequence) const
+{
+	if (sequence == 0 || m_sequences[sequence % Size] != sequence)
+	{
+		return nullptr;
+	}
+	return &m_worlds[sequence % Size];
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Entity.hpp"
+#include "Net.hpp"
+#include "Tags.hpp"
+#include <unordered_map>
+
+// an entity as the network sees it, positions in 1/8 pixel and velocities in 1/64 pixel per tick
+struct NetEntity
+{
+	uint8_t		tag			= 0;
+	int16_t		x			= 0;
+	int16_t		y			= 0;
+	int16_t		vx			= 0;
+	int16_t		vy			= 0;
+	uint8_t		angle		= 0;	// in 1/256 of a turn
+	uint8_t		radius		= 0;
+	uint8_t		points		= 0;
+	uint8_t		thickness	= 0;
+	sf::Color	fill		= sf::Color(0, 0, 0, 0);
+	sf::Color	outline		= sf::Color(0, 0, 0, 0);
+
+	Vec2 position() const;
+	Vec2 velocity() const;
+	float degrees() const;
+
+	bool operator == (const NetEntity& rhs) const;
+};
+
+typedef std::unordered_map<uint32_t, NetEntity> NetWorld;
+
+NetEntity quantize(const Entity& entity);
+
+// writes only the fields of e that differ from base, returns false (writing nothing) if none do
+bool writeEntityDelta(PacketWriter& out, uint32_t id, const NetEntity& e, const NetEntity& base);
+
+// reads one entity delta and applies it on top of the world
+void readEntityDelta(PacketReader& in, NetWorld& world);
+
+// the worlds of the most recent snapshots by sequence, server and client both keep one to delta against
+class SnapshotHistory
+{
+	static const size_t Size = 32;
+
+	NetWorld	m_worlds[Size];
+	uint32_t	m_sequences[Size] = {};
+
+public:
+
+	void store(uint32_t sequence, const NetWorld& world);
+	const NetWorld* find(uint32_t sequence) const;	// nullptr once the sequence is no longer kept
+};
@@ -0,0 +1,53 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::resize(float width, float height, float cellSize)
+{
+	m_cellSize = cellSize;
+	m_width = (int)std::ceil(width / cellSize);
+	m_height = (int)std::ceil(height / cellSize);
+	m_start.assign(m_width * m_height + 1, 0);
+}
+
+int SpatialGrid::cellX(float x) const
+{
+	return std::min(m_width - 1, std::max(0, (int)(x / m_cellSize)));
+}
+
+int SpatialGrid::cellY(float y) const
+{
+	return std::min(m_height - 1, std::max(0, (int)(y / m_cellSize)));
+}
+
+void SpatialGrid::build(const std::vector<Vec2>& points)
+{
+	std::fill(m_start.begin(), m_start.end(), 0);
+	m_cellOf.resize(points.size());
+	m_items.resize(points.size());
+
+	// count the points per cell, shifted by one so the running sum below gives each cell's start
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		m_cellOf[i] = cellY(points[i].y) * m_width + cellX(points[i].x);
+		m_start[m_cellOf[i] + 1]++;
+	}
+
+	for (size_t c = 1; c < m_start.size(); c++)
+	{
+		m_start[c] += m_start[c - 1];
+	}
+
+	// m_start is used as the insert position of each cell, which leaves it at the next cell's start
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		m_items[m_start[m_cellOf[i]]++] = (int)i;
+	}
+
+	// so everything is shifted back by one cell
+	for (size_t c = m_start.size() - 1; c > 0; c--)
+	{
+		m_start[c] = m_start[c - 1];
+	}
+	m_start[0] = 0;
+}
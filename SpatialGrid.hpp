@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Vec2.hpp"
+#include <vector>
+
+// buckets points into square cells so a neighbour query only looks at the 3x3 cells around a position
+// rebuilt from scratch every tick with a counting sort, two passes over the points and no allocation once warm
+// points outside the grid are kept in its edge cells
+class SpatialGrid
+{
+	float				m_cellSize	= 64.0f;
+	int					m_width		= 0;	// in cells
+	int					m_height	= 0;
+	std::vector<int>	m_start;			// where each cell's points begin in m_items, one extra entry at the end
+	std::vector<int>	m_items;			// point indices ordered by cell
+	std::vector<int>	m_cellOf;			// cell of each point
+
+	int cellX(float x) const;
+	int cellY(float y) const;
+
+public:
+
+	void resize(float width, float height, float cellSize);	// cellSize must be at least the query radius
+	void build(const std::vector<Vec2>& points);
+
+	// calls visit(index) for every point in the cells around pos until it returns false
+	template <class Visit>
+	void forEachNear(const Vec2& pos, Visit visit) const
+	{
+		int cx = cellX(pos.x), cy = cellY(pos.y);
+
+		for (int y = cy - 1; y <= cy + 1; y++)
+		{
+			for (int x = cx - 1; x <= cx + 1; x++)
+			{
+				if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+				{
+					continue;
+				}
+
+				int cell = y * m_width + x;
+				for (int i = m_start[cell]; i < m_start[cell + 1]; i++)
+				{
+					if (!visit(m_items[i]))
+					{
+						return;
+					}
+				}
+			}
+		}
+	}
+};
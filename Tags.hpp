@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// entity tags as one byte numbers, shared by network snapshots and the event log
+// new tags go at the end so numbers already in logs keep their meaning
+
+inline const std::string* tagNames(size_t& count)
+{
+	static const std::string names[] = { "default", "player", "enemy", "small-enemy", "bullet", "special" };
+	count = sizeof(names) / sizeof(names[0]);
+	return names;
+}
+
+inline uint8_t tagId(const std::string& tag)
+{
+	size_t count;
+	const std::string* names = tagNames(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (names[i] == tag)
+		{
+			return (uint8_t)i;
+		}
+	}
+	return 0;
+}
+
+inline const std::string& tagName(uint8_t tag)
+{
+	size_t count;
+	const std::string* names = tagNames(count);
+	return tag < count ? names[tag] : names[0];
+}
@@ -0,0 +1,172 @@
+#include "Trace.hpp"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace
+{
+	std::atomic<bool> s_enabled{ false };
+
+	// one recorded zone or counter sample
+	struct Event
+	{
+		const char*	name;
+		int64_t		time;
+		int64_t		value;		// duration of a zone, value of a counter
+		bool		isCounter;
+	};
+
+	// written only by its own thread, read by save() up to the published count
+	struct ThreadBuffer
+	{
+		static const size_t		Capacity = 1 << 18;
+
+		std::vector<Event>		events = std::vector<Event>(Capacity);
+		std::atomic<size_t>		count{ 0 };
+		std::atomic<size_t>		dropped{ 0 };		// events that didn't fit
+		std::atomic<int>		capture{ -1 };		// the capture the events belong to
+		int						tid = 0;
+		std::string				name;
+	};
+
+	static const auto						s_start = std::chrono::steady_clock::now();
+	static std::atomic<int>					s_capture{ 0 };		// bumped every time tracing is turned on
+	static std::mutex						s_buffersMutex;		// guards the list only, never the events
+	static std::vector<std::shared_ptr<ThreadBuffer>>	s_buffers;
+
+	static thread_local ThreadBuffer*	t_buffer = nullptr;
+	static thread_local std::string		t_name;
+
+	// a thread gets its buffer on its first event, so threads that are never traced cost no memory
+	// the list keeps every buffer alive, so a thread's events can still be saved after it exits
+	static ThreadBuffer& threadBuffer()
+	{
+		if (!t_buffer)
+		{
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			s_buffers.push_back(std::make_shared<ThreadBuffer>());
+			t_buffer = s_buffers.back().get();
+			t_buffer->tid = (int)s_buffers.size();
+			t_buffer->name = t_name;
+		}
+		return *t_buffer;
+	}
+
+	static void record(const Event& e)
+	{
+		ThreadBuffer& b = threadBuffer();
+
+		// only the owning thread empties its buffer, on its first event of a new capture
+		int capture = s_capture.load(std::memory_order_relaxed);
+		if (b.capture.load(std::memory_order_relaxed) != capture)
+		{
+			b.count.store(0, std::memory_order_relaxed);
+			b.dropped.store(0, std::memory_order_relaxed);
+			b.capture.store(capture, std::memory_order_release);
+		}
+
+		size_t n = b.count.load(std::memory_order_relaxed);
+		if (n == ThreadBuffer::Capacity)
+		{
+			b.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		b.events[n] = e;
+		b.count.store(n + 1, std::memory_order_release);
+	}
+
+	void setEnabled(bool enabled)
+	{
+		// every trace saved starts where tracing was last turned on, not at the first one
+		if (enabled && !s_enabled.load(std::memory_order_relaxed))
+		{
+			s_capture.fetch_add(1, std::memory_order_relaxed);
+		}
+		s_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool isEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	void setThreadName(const std::string& name)
+	{
+		t_name = name;
+		if (t_buffer)
+		{
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			t_buffer->name = name;
+		}
+	}
+
+	int64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_start).count();
+	}
+
+	void zone(const char* name, int64_t start, int64_t end)
+	{
+		record(Event{ name, start, end - start, false });
+	}
+
+	void counter(const char* name, int64_t value)
+	{
+		record(Event{ name, now(), value, true });
+	}
+
+	bool save(const std::string& path)
+	{
+		std::ofstream fout(path);
+		if (!fout)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(s_buffersMutex);
+		fout << "{\"traceEvents\":[\n";
+		bool first = true;
+		size_t totalDropped = 0;
+
+		for (auto& b : s_buffers)
+		{
+			// a thread that recorded nothing since tracing was turned on still holds an older capture
+			bool current = b->capture.load(std::memory_order_acquire) == s_capture.load(std::memory_order_relaxed);
+			size_t n = current ? b->count.load(std::memory_order_acquire) : 0;
+			size_t dropped = current ? b->dropped.load(std::memory_order_relaxed) : 0;
+			totalDropped += dropped;
+			std::string name = b->name.empty() ? "thread " + std::to_string(b->tid) : b->name;
+
+			fout << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << b->tid
+				<< ",\"args\":{\"name\":\"" << name << "\"}}";
+			first = false;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				const Event& e = b->events[i];
+				if (e.isCounter)
+				{
+					fout << ",\n{\"ph\":\"C\",\"name\":\"" << e.name << "\",\"ts\":" << e.time << ",\"pid\":1,\"tid\":" << b->tid
+						<< ",\"args\":{\"value\":" << e.value << "}}";
+				}
+				else
+				{
+					fout << ",\n{\"ph\":\"X\",\"name\":\"" << e.name << "\",\"ts\":" << e.time << ",\"dur\":" << e.value
+						<< ",\"pid\":1,\"tid\":" << b->tid << "}";
+				}
+			}
+
+			if (dropped > 0)
+			{
+				fout << ",\n{\"ph\":\"i\",\"name\":\"dropped " << dropped << " events\",\"ts\":" << now()
+					<< ",\"pid\":1,\"tid\":" << b->tid << ",\"s\":\"t\"}";
+			}
+		}
+
+		// events that didn't fit any thread's buffer, so a viewer of the file knows it is incomplete
+		fout << "\n],\"otherData\":{\"droppedEvents\":" << totalDropped << "}}\n";
+		return true;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped trace zones and counters for a timeline of every system, saved as Chrome / Perfetto trace-event json
+// Every thread writes to its own buffer without locking. While tracing is off a zone costs one relaxed load,
+// building with SHAPEWARS_NO_TRACE defined removes zones and counters entirely.
+namespace Trace
+{
+	extern std::atomic<bool> s_enabled;
+
+	void setEnabled(bool enabled);
+	bool isEnabled();
+	void setThreadName(const std::string& name);		// shown in the trace viewer instead of the thread id
+
+	int64_t now();										// microseconds since the process started
+	void zone(const char* name, int64_t start, int64_t end);
+	void counter(const char* name, int64_t value);
+
+	bool save(const std::string& path);					// writes every event recorded so far, from all threads
+
+	// records the time from its construction to its destruction, names must be string literals
+	class Zone
+	{
+		const char*	m_name;
+		int64_t		m_start;
+
+	public:
+
+		Zone(const char* name)
+			: m_name(name)
+			, m_start(s_enabled.load(std::memory_order_relaxed) ? now() : -1)
+		{
+		}
+
+		~Zone()
+		{
+			if (m_start >= 0)
+			{
+				zone(m_name, m_start, now());
+			}
+		}
+	};
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef SHAPEWARS_NO_TRACE
+#define TRACE_ZONE(name)
+#define TRACE_COUNTER(name, value)
+#else
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value) do { if (Trace::s_enabled.load(std::memory_order_relaxed)) { Trace::counter(name, value); } } while (0)
+#endif
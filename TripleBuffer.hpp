@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+// hands values from one writer thread to one reader thread without either waiting on the other's work
+// the writer fills back() and publishes it, the reader takes the latest published value,
+// a value published before the reader got to it is skipped. The three slots are reused, so a
+// value's vectors keep their capacity and steady state needs no allocations
+template <class T>
+class TripleBuffer
+{
+	T						m_slots[3];
+	int						m_back		= 0;		// slot the writer fills
+	int						m_ready		= 1;		// latest published slot
+	int						m_front		= 2;		// slot the reader is using
+	bool					m_fresh		= false;	// m_ready holds a value the reader hasn't taken
+	bool					m_closed	= false;
+	std::mutex				m_mutex;				// only held to swap indices
+	std::condition_variable	m_published;
+
+public:
+
+	// writer: the slot to fill, only the writer touches it until publish()
+	T& back()
+	{
+		return m_slots[m_back];
+	}
+
+	// writer: makes back() the latest value, the old latest value becomes the new back()
+	void publish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::swap(m_back, m_ready);
+			m_fresh = true;
+		}
+		m_published.notify_one();
+	}
+
+	// reader: waits for a value newer than the last one taken, nullptr once closed
+	// the value stays valid and untouched by the writer until the next acquire()
+	const T* acquire()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_published.wait(lock, [this] { return m_fresh || m_closed; });
+		if (!m_fresh)
+		{
+			return nullptr;
+		}
+		std::swap(m_front, m_ready);
+		m_fresh = false;
+		return &m_slots[m_front];
+	}
+
+	// wakes the reader for good, acquire() returns nullptr from now on
+	void close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_closed = true;
+			m_fresh = false;
+		}
+		m_published.notify_one();
+	}
+};
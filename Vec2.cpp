@@ -1,87 +1,87 @@
-#include "Vec2.hpp"
-#include <math.h>
-
-Vec2::Vec2()
-{
-
-}
-
-Vec2::Vec2(float xin, float yin)
-	: x(xin), y(yin)
-{
-
-}
-
-Vec2 Vec2::operator + (const Vec2& rhs) const
-{
-	return Vec2(x + rhs.x, y + rhs.y);
-}
-
-Vec2 Vec2::operator - (const Vec2& rhs) const
-{
-	return Vec2(x - rhs.x, y - rhs.y);
-}
-
-Vec2 Vec2::operator / (const float val) const
-{
-	return Vec2(x / val, y / val);
-}
-
-Vec2 Vec2::operator * (const float val) const
-{
-	return Vec2(x * val, y * val);
-}
-
-bool Vec2::operator == (const Vec2& rhs) const
-{
-	return (x == rhs.x && y == rhs.y);
-}
-
-bool Vec2::operator != (const Vec2& rhs) const
-{
-	return (x != rhs.x || y != rhs.y);
-}
-
-void Vec2::operator += (const Vec2& rhs)
-{
-	x += rhs.x;
-	y += rhs.y;
-}
-
-void Vec2::operator -= (const Vec2& rhs)
-{
-	x -= rhs.x;
-	y -= rhs.y;
-}
-
-void Vec2::operator *= (const float val)
-{
-	x *= val;
-	y *= val;
-}
-
-void Vec2::operator /= (const float val)
-{
-	x /= val;
-	y /= val;
-}
-
-Vec2 Vec2::dist(const Vec2& rhs) const
-{
-	return Vec2(rhs.x - x, rhs.y - y);
-}
-
-float Vec2::length() const
-{
-	return sqrt(pow(x, 2) + pow(y, 2));
-}
-
-void Vec2::bounceX()
-{
-	x *= -1.00f;
-}
-
-void Vec2::bounceY()
-{
-	y *= -1.00f;
+#include "Vec2.hpp"
+#include <math.h>
+
+Vec2::Vec2()
+{
+
+}
+
+Vec2::Vec2(float xin, float yin)
+	: x(xin), y(yin)
+{
+
+}
+
+Vec2 Vec2::operator + (const Vec2& rhs) const
+{
+	return Vec2(x + rhs.x, y + rhs.y);
+}
+
+Vec2 Vec2::operator - (const Vec2& rhs) const
+{
+	return Vec2(x - rhs.x, y - rhs.y);
+}
+
+Vec2 Vec2::operator / (const float val) const
+{
+	return Vec2(x / val, y / val);
+}
+
+Vec2 Vec2::operator * (const float val) const
+{
+	return Vec2(x * val, y * val);
+}
+
+bool Vec2::operator == (const Vec2& rhs) const
+{
+	return (x == rhs.x && y == rhs.y);
+}
+
+bool Vec2::operator != (const Vec2& rhs) const
+{
+	return (x != rhs.x || y != rhs.y);
+}
+
+void Vec2::operator += (const Vec2& rhs)
+{
+	x += rhs.x;
+	y += rhs.y;
+}
+
+void Vec2::operator -= (const Vec2& rhs)
+{
+	x -= rhs.x;
+	y -= rhs.y;
+}
+
+void Vec2::operator *= (const float val)
+{
+	x *= val;
+	y *= val;
+}
+
+void Vec2::operator /= (const float val)
+{
+	x /= val;
+	y /= val;
+}
+
+Vec2 Vec2::dist(const Vec2& rhs) const
+{
+	return Vec2(rhs.x - x, rhs.y - y);
+}
+
+float Vec2::length() const
+{
+	return sqrt(pow(x, 2) + pow(y, 2));
+}
+
+void Vec2::bounceX()
+{
+	x *= -1.00f;
+}
+
+void Vec2::bounceY()
+{
+	y *= -1.00f;
 }
\ No newline at end of file
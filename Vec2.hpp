@@ -1,30 +1,30 @@
-#pragma once
-
-class Vec2
-{
-public:
-
-	float x = 0;
-	float y = 0;
-
-	Vec2();
-	Vec2(float xin, float yin);
-
-	bool operator == (const Vec2& rhs) const;
-	bool operator != (const Vec2& rhs) const;
-
-	Vec2 operator + (const Vec2& rhs) const;
-	Vec2 operator - (const Vec2& rhs) const;
-	Vec2 operator / (const float val) const;
-	Vec2 operator * (const float val) const;
-
-	void operator += (const Vec2& rhs);
-	void operator -= (const Vec2& rhs);
-	void operator *= (const float val);
-	void operator /= (const float val);
-
-	Vec2 dist(const Vec2& rhs) const;
-	float length() const;
-	void bounceX();
-	void bounceY();
+#pragma once
+
+class Vec2
+{
+public:
+
+	float x = 0;
+	float y = 0;
+
+	Vec2();
+	Vec2(float xin, float yin);
+
+	bool operator == (const Vec2& rhs) const;
+	bool operator != (const Vec2& rhs) const;
+
+	Vec2 operator + (const Vec2& rhs) const;
+	Vec2 operator - (const Vec2& rhs) const;
+	Vec2 operator / (const float val) const;
+	Vec2 operator * (const float val) const;
+
+	void operator += (const Vec2& rhs);
+	void operator -= (const Vec2& rhs);
+	void operator *= (const float val);
+	void operator /= (const float val);
+
+	Vec2 dist(const Vec2& rhs) const;
+	float length() const;
+	void bounceX();
+	void bounceY();
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "WorkerPool.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	for (auto& t : m_threads)
+	{
+		t.join();
+	}
+}
+
+void WorkerPool::start(unsigned int threads)
+{
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		m_threads.emplace_back(&WorkerPool::worker, this);
+	}
+}
+
+size_t WorkerPool::threads() const
+{
+	return m_threads.size();
+}
+
+void WorkerPool::parallelFor(size_t count, size_t chunk, const Job& job)
+{
+	chunk = std::max((size_t)1, chunk);
+
+	// waking the workers costs more than a single chunk of work
+	if (m_threads.empty() || count <= chunk)
+	{
+		job(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = &job;
+		m_count = count;
+		m_chunk = chunk;
+		m_next = 0;
+		m_busy = (int)m_threads.size();
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	work();
+
+	// the job lives on the caller's stack, so every worker has to be done with it before returning
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_busy == 0; });
+	m_job = nullptr;
+}
+
+void WorkerPool::worker()
+{
+	Trace::setThreadName("worker");
+	int seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+			if (m_stopping)
+			{
+				return;
+			}
+			seen = m_generation;
+		}
+
+		work();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_busy == 0)
+		{
+			m_done.notify_one();
+		}
+	}
+}
+
+void WorkerPool::work()
+{
+	TRACE_ZONE("WorkerPool::work");
+
+	for (size_t begin = m_next.fetch_add(m_chunk); begin < m_count; begin = m_next.fetch_add(m_chunk))
+	{
+		(*m_job)(begin, std::min(begin + m_chunk, m_count));
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a few long lived threads that split a loop into chunks, so a system can run on every core
+// without starting threads each tick. The calling thread takes chunks as well, and with no
+// threads started parallelFor() just runs the loop, which is what headless games use
+class WorkerPool
+{
+	using Job = std::function<void(size_t begin, size_t end)>;
+
+	std::vector<std::thread>	m_threads;
+	std::mutex					m_mutex;
+	std::condition_variable		m_wake;			// a new job was posted, or the pool is stopping
+	std::condition_variable		m_done;			// the last busy worker finished the job
+	const Job*					m_job		= nullptr;
+	size_t						m_count		= 0;
+	size_t						m_chunk		= 0;
+	std::atomic<size_t>			m_next{ 0 };	// start of the next chunk to hand out
+	int							m_busy		= 0;
+	int							m_generation = 0;	// bumped for every job so workers don't run one twice
+	bool						m_stopping	= false;
+
+	void worker();
+	void work();
+
+public:
+
+	~WorkerPool();
+
+	void start(unsigned int threads);
+	size_t threads() const;
+
+	// calls job(begin, end) for chunks of at most chunk indices covering [0, count), returns once all are done
+	void parallelFor(size_t count, size_t chunk, const Job& job);
+};
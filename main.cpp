@@ -1,8 +1,78 @@
-#include <SFML/Graphics.hpp>
-#include "Game.hpp"
-
-int main(int argc, char* argv[])
-{
-	Game g("config.txt");
-	g.run();
+#include <SFML/Graphics.hpp>
+#include "Game.hpp"
+#include "BatchRunner.hpp"
+#include "Server.hpp"
+#include "Client.hpp"
+#include "LocalityBenchmark.hpp"
+#include "Trace.hpp"
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+int main(int argc, char* argv[])
+{
+	// "--trace" in front of any mode records a trace from the start, saved to trace.json on exit
+	if (argc > 1 && std::string(argv[1]) == "--trace")
+	{
+		Trace::setThreadName("main");
+		Trace::setEnabled(true);
+		argv[1] = argv[0];
+		argc--;
+		argv++;
+	}
+
+	try
+	{
+		std::string mode = argc > 1 ? argv[1] : "";
+
+		// "--batch sweep.txt" plays every run of the sweep file without windows, on all cores
+		if (mode == "--batch" && argc > 2)
+		{
+			BatchRunner runner("config.txt", argv[2]);
+			runner.run(std::thread::hardware_concurrency());
+			runner.report(std::cout);
+			if (Trace::isEnabled())
+			{
+				Trace::save("trace.json");
+			}
+			return 0;
+		}
+
+		// "--server socket [ticks]" runs the authoritative game for clients on this machine
+		if (mode == "--server" && argc > 2)
+		{
+			Server server("config.txt", argv[2]);
+			server.run(argc > 3 ? std::stoi(argv[3]) : 0);
+			if (Trace::isEnabled())
+			{
+				Trace::save("trace.json");
+			}
+			return 0;
+		}
+
+		// "--client socket" plays on a server, "--standin socket [ticks]" plays scripted without a window
+		if ((mode == "--client" || mode == "--standin") && argc > 2)
+		{
+			std::string server = argv[2];
+			Client client("config.txt", server, server + "." + std::to_string(getpid()), mode == "--standin");
+			client.run(argc > 3 ? std::stoi(argv[3]) : 0);
+			return 0;
+		}
+
+		// "--locality count ticks [on|off]" times a neighbour pass over a large scene with and without spatial order
+		if (mode == "--locality" && argc > 3)
+		{
+			LocalityBenchmark benchmark(std::stoul(argv[2]), std::stoi(argv[3]));
+			benchmark.run(argc > 4 ? argv[4] : "", std::cout);
+			return 0;
+		}
+
+		Game g("config.txt");
+		g.run();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return -1;
+	}
 }
\ No newline at end of file
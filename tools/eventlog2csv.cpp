@@ -0,0 +1,41 @@
+// Converts an event log written by the game (path.000, path.001, ...) to csv on stdout
+// usage: eventlog2csv path
+
+#include "../EventLog.hpp"
+#include "../Tags.hpp"
+#include <cstdio>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "usage: eventlog2csv path\n";
+		return -1;
+	}
+
+	std::cout << "sequence,tick,event,tag,entity,other_tag,other,value,x,y\n";
+
+	for (int segment = 0; ; segment++)
+	{
+		char name[16];
+		snprintf(name, sizeof(name), ".%03d", segment);
+
+		FILE* fin = fopen((std::string(argv[1]) + name).c_str(), "rb");
+		if (!fin)
+		{
+			break;
+		}
+
+		// a segment ends at its first unwritten (all zero) record
+		EventRecord r;
+		while (fread(&r, sizeof(r), 1, fin) == 1 && r.type != EVENT_NONE)
+		{
+			std::cout << r.sequence << "," << r.tick << "," << eventName(r.type) << "," << tagName(r.tag) << "," << r.entity << ","
+				<< (r.otherTag ? tagName(r.otherTag) : "") << "," << r.other << "," << r.value << ","
+				<< r.x << "," << r.y << "\n";
+		}
+
+		fclose(fin);
+	}
+}